@@ -0,0 +1,76 @@
+/*
+Accuracy versus cost of the pendulum integrators over a 20 s free swing.
+
+The reference is RK4 at a 1e-4 s step. For each integrator and plant time
+step the table shows the final-angle error, the accepted (sub)steps, the
+right-hand-side evaluations and the wall time.
+*/
+
+#include "InvertedPendulumSystem.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+namespace
+{
+    constexpr double duration = 20.0;
+
+    double run(Integrator integrator, double time_step, IntegrationStats &stats, double &seconds)
+    {
+        BasicInvertedPendulumSystem<double> pendulum(time_step);
+        pendulum.setIntegrator(integrator, {1e-8, 1e-8});
+
+        auto start = std::chrono::steady_clock::now();
+        long long steps = std::llround(duration / time_step);
+        for (long long i = 0; i < steps; ++i)
+            pendulum.update(0.0);
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        stats = pendulum.integrationStats();
+        return pendulum.getOutput();
+    }
+
+    const char *name(Integrator integrator)
+    {
+        switch (integrator)
+        {
+        case Integrator::SemiImplicitEuler:
+            return "semi-implicit Euler";
+        case Integrator::ExplicitEuler:
+            return "explicit Euler";
+        case Integrator::RK4:
+            return "RK4";
+        case Integrator::RK45:
+            return "RK45";
+        }
+        return "";
+    }
+}
+
+int main()
+{
+    IntegrationStats stats;
+    double seconds;
+    const double reference = run(Integrator::RK4, 1e-4, stats, seconds);
+
+    std::printf("%-20s %10s %12s %10s %12s %12s %10s\n", "integrator", "time_step", "error", "steps", "evaluations", "max local", "ms");
+
+    struct Case
+    {
+        Integrator integrator;
+        double time_step;
+    };
+    const Case cases[] = {
+        {Integrator::SemiImplicitEuler, 1e-2}, {Integrator::SemiImplicitEuler, 1e-3}, {Integrator::SemiImplicitEuler, 1e-4},
+        {Integrator::ExplicitEuler, 1e-3}, {Integrator::RK4, 1e-1}, {Integrator::RK4, 1e-2},
+        {Integrator::RK45, 1e-2}, {Integrator::RK45, 1e-1}, {Integrator::RK45, 1.0}};
+
+    for (const Case &c : cases)
+    {
+        double angle = run(c.integrator, c.time_step, stats, seconds);
+        std::printf("%-20s %10g %12.3e %10lld %12lld %12.3e %10.3f\n", name(c.integrator), c.time_step,
+                    std::fabs(angle - reference), stats.steps, stats.derivativeEvaluations,
+                    stats.maxErrorEstimate, seconds * 1e3);
+    }
+    return 0;
+}
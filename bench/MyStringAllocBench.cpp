@@ -0,0 +1,130 @@
+/*
+Heap allocations and time per MyString operation.
+
+Replaces the global operator new / delete to count every allocation made
+while a workload runs. Short strings should cost no allocations at all;
+long ones one per owned copy. Build with optimisations, e.g. -O2.
+*/
+
+#include "MyString.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+namespace
+{
+    constexpr int iterations = 100000;
+
+    long long allocations = 0;
+    long long bytesAllocated = 0;
+
+    volatile size_t sink; // keeps results observable
+
+    template <typename Workload>
+    void benchmark(const char *name, Workload &&workload)
+    {
+        long long allocationsBefore = allocations;
+        long long bytesBefore = bytesAllocated;
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+            workload();
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        double perOp = 1.0 / iterations;
+        std::printf("%-28s %8.2f allocs/op %9.1f bytes/op %9.1f ns/op\n", name,
+                    (allocations - allocationsBefore) * perOp, (bytesAllocated - bytesBefore) * perOp,
+                    std::chrono::duration<double, std::nano>(elapsed).count() * perOp);
+    }
+}
+
+void *operator new(size_t size)
+{
+    ++allocations;
+    bytesAllocated += static_cast<long long>(size);
+    if (void *p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void *operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+// std::pmr::new_delete_resource(), MyString's default, allocates with alignment
+void *operator new(size_t size, std::align_val_t alignment)
+{
+    ++allocations;
+    bytesAllocated += static_cast<long long>(size);
+    size_t align = static_cast<size_t>(alignment);
+    if (void *p = std::aligned_alloc(align, (size + align - 1) / align * align)) // size must be a multiple
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p, size_t) noexcept
+{
+    std::free(p);
+}
+
+int main()
+{
+    const MyString shortString("sensor");
+    const MyString longString("a much longer string that cannot be stored inline");
+
+    std::printf("%d iterations per workload\n", iterations);
+    benchmark("default construct", [&]()
+              { MyString s; sink = s.size(); });
+    benchmark("construct short", [&]()
+              { MyString s("sensor"); sink = s.size(); });
+    benchmark("construct long", [&]()
+              { MyString s("a much longer string that cannot be stored inline"); sink = s.size(); });
+    benchmark("copy short", [&]()
+              { MyString s(shortString); sink = s.size(); });
+    benchmark("copy long", [&]()
+              { MyString s(longString); sink = s.size(); });
+    benchmark("move short", [&]()
+              { MyString s(shortString); MyString t(std::move(s)); sink = t.size(); });
+    benchmark("concatenate short", [&]()
+              { MyString s = shortString + shortString; sink = s.size(); });
+    benchmark("concatenate long", [&]()
+              { MyString s = longString + shortString; sink = s.size(); });
+    benchmark("concatenate chain of 4", [&]()
+              { MyString s = longString + shortString + longString + shortString; sink = s.size(); });
+    benchmark("append 64 short pieces", [&]()
+              {
+        MyString s;
+        for (int i = 0; i < 64; ++i)
+            s += shortString;
+        sink = s.size(); });
+
+    return 0;
+}
@@ -0,0 +1,104 @@
+/*
+Short-lived MyStrings built by many threads at once: global heap versus a
+per-request MonotonicArena versus the thread-local pool.
+
+Each thread handles a series of "requests"; a request builds a few dozen
+heap-sized strings (construct, concatenate, append) and drops them all.
+With the arena the request's memory is bump-allocated from a stack buffer
+and released in one go. Build with optimisations, e.g. -O2.
+*/
+
+#include "MemoryArena.h"
+#include "MyString.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr int requestsPerThread = 20000;
+    constexpr int stringsPerRequest = 32;
+
+    std::atomic<size_t> sink{0}; // keeps results observable
+
+    void handleRequest(int request, std::pmr::memory_resource *resource)
+    {
+        std::pmr::vector<MyString> strings(resource);
+        strings.reserve(stringsPerRequest);
+
+        MyString prefix("request handled by a worker thread: ", resource);
+        for (int i = 0; i < stringsPerRequest; ++i)
+        {
+            MyString line(prefix + "item " + prefix, resource);
+            line += (request + i) % 2 ? "odd" : "even";
+            strings.push_back(std::move(line));
+        }
+
+        size_t total = 0;
+        for (const MyString &s : strings)
+            total += s.size();
+        sink.fetch_add(total, std::memory_order_relaxed);
+    }
+
+    enum class Storage
+    {
+        GlobalHeap,
+        Arena,
+        ThreadLocalPool
+    };
+
+    void worker(Storage storage)
+    {
+        for (int request = 0; request < requestsPerThread; ++request)
+        {
+            switch (storage)
+            {
+            case Storage::GlobalHeap:
+                handleRequest(request, std::pmr::new_delete_resource());
+                break;
+            case Storage::Arena:
+            {
+                alignas(16) char buffer[16384];
+                MonotonicArena arena(buffer, sizeof(buffer));
+                handleRequest(request, &arena);
+                break;
+            }
+            case Storage::ThreadLocalPool:
+                handleRequest(request, threadLocalPool());
+                break;
+            }
+        }
+    }
+
+    double nanosecondsPerRequest(Storage storage, int threads)
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t)
+            workers.emplace_back(worker, storage);
+        for (std::thread &w : workers)
+            w.join();
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        return std::chrono::duration<double, std::nano>(elapsed).count() / requestsPerThread;
+    }
+}
+
+int main()
+{
+    std::printf("%d requests per thread, %d strings per request; ns per request per thread\n",
+                requestsPerThread, stringsPerRequest);
+    std::printf("%8s %12s %12s %12s\n", "threads", "global heap", "arena", "thread pool");
+
+    for (int threads = 1; threads <= 8; threads *= 2)
+    {
+        double heap = nanosecondsPerRequest(Storage::GlobalHeap, threads);
+        double arena = nanosecondsPerRequest(Storage::Arena, threads);
+        double pool = nanosecondsPerRequest(Storage::ThreadLocalPool, threads);
+        std::printf("%8d %12.0f %12.0f %12.0f\n", threads, heap, arena, pool);
+    }
+    return 0;
+}
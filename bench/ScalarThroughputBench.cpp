@@ -0,0 +1,70 @@
+/*
+Closed-loop throughput of BasicPID + each plant for every scalar type.
+
+Runs many independent loops side by side over vectors of plant and PID
+objects (array-of-structs, no virtual calls). The numbers are for that
+layout; see PlantBatch for a structure-of-arrays version. Build with
+optimisations, e.g. -O3 -march=native.
+*/
+
+#include "BasicPID.h"
+#include "FixedPoint.h"
+#include "InvertedPendulumSystem.h"
+#include "PositionSystem.h"
+#include "TemperatureSystem.h"
+#include "VelocitySystem.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+    constexpr int loops = 1024;
+    constexpr int steps = 2000;
+
+    volatile double sink; // keeps results observable
+
+    template <template <typename> class Plant, typename Scalar>
+    double nanosecondsPerStep(double Kp, double Ki, double Kd, double setpoint)
+    {
+        std::vector<Plant<Scalar>> plants(loops);
+        std::vector<BasicPID<Scalar>> pids(loops, BasicPID<Scalar>(Scalar(Kp), Scalar(Ki), Scalar(Kd)));
+        const Scalar target(setpoint);
+
+        auto start = std::chrono::steady_clock::now();
+        for (int step = 0; step < steps; ++step)
+        {
+            for (int i = 0; i < loops; ++i)
+                plants[i].update(pids[i].control(target - plants[i].getOutput()));
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        double checksum = 0.0;
+        for (const auto &plant : plants)
+            checksum += static_cast<double>(plant.getOutput());
+        sink = checksum;
+
+        return std::chrono::duration<double, std::nano>(elapsed).count() / (static_cast<double>(loops) * steps);
+    }
+
+    template <typename Scalar>
+    void benchmark(const char *name)
+    {
+        std::printf("%-8s %12.2f %12.2f %12.2f %12.2f\n", name,
+                    nanosecondsPerStep<BasicPositionSystem, Scalar>(1.0, 0.1, 0.05, 1.0),
+                    nanosecondsPerStep<BasicVelocitySystem, Scalar>(1.0, 0.1, 0.05, 1.0),
+                    nanosecondsPerStep<BasicTemperatureSystem, Scalar>(1.0, 0.1, 0.05, 100.0),
+                    nanosecondsPerStep<BasicInvertedPendulumSystem, Scalar>(30.0, 1.0, 5.0, 0.0));
+    }
+}
+
+int main()
+{
+    std::printf("ns per closed-loop step (%d loops x %d steps)\n", loops, steps);
+    std::printf("%-8s %12s %12s %12s %12s\n", "scalar", "position", "velocity", "temperature", "pendulum");
+    benchmark<double>("double");
+    benchmark<float>("float");
+    benchmark<Q32_32>("Q32.32");
+    benchmark<Q16_16>("Q16.16");
+    return 0;
+}
@@ -0,0 +1,82 @@
+/*
+StateSpacePlant instances against the handwritten plants.
+
+Each variant runs the same closed loop (BasicPID(1.0, 0.1, 0.05))
+for many steps; the table shows ns per step. "virtual" calls through IPlant&,
+"template" uses the Basic*System class directly. Build with -O2 or higher.
+*/
+
+#include "BasicPID.h"
+#include "InvertedPendulumSystem.h"
+#include "PositionSystem.h"
+#include "StateSpacePlant.h"
+#include "TemperatureSystem.h"
+#include "VelocitySystem.h"
+#include <chrono>
+#include <cstdio>
+
+namespace
+{
+    constexpr int steps = 5000000;
+
+    volatile double sink;
+
+    template <typename Step>
+    double nanosecondsPerStep(Step &&step)
+    {
+        auto start = std::chrono::steady_clock::now();
+        double last = 0.0;
+        for (int i = 0; i < steps; ++i)
+            last = step();
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        sink = last;
+        return std::chrono::duration<double, std::nano>(elapsed).count() / steps;
+    }
+
+    template <typename Plant>
+    double direct(Plant plant, double setpoint)
+    {
+        BasicPID<double> pid(1.0, 0.1, 0.05);
+        return nanosecondsPerStep([&]()
+                                  { return plant.update(pid.control(setpoint - plant.getOutput())); });
+    }
+
+    double virtualCall(IPlant &plant, double setpoint)
+    {
+        BasicPID<double> pid(1.0, 0.1, 0.05);
+        return nanosecondsPerStep([&]()
+                                  { return plant.update(pid.control(setpoint - plant.getOutput())); });
+    }
+
+    template <size_t NX>
+    double stateSpace(StateSpacePlant<NX, 1, 1> plant, double setpoint)
+    {
+        BasicPID<double> pid(1.0, 0.1, 0.05);
+        return nanosecondsPerStep([&]()
+                                  { return plant.update({pid.control(setpoint - plant.output()[0])})[0]; });
+    }
+}
+
+int main()
+{
+    std::printf("ns per closed-loop step (%d steps)\n", steps);
+    std::printf("%-12s %10s %10s %12s\n", "plant", "virtual", "template", "state-space");
+
+    PositionSystem position;
+    std::printf("%-12s %10.2f %10.2f %12.2f\n", "position", virtualCall(position, 1.0),
+                direct(BasicPositionSystem<double>(), 1.0), stateSpace(makePositionStateSpace(), 1.0));
+
+    VelocitySystem velocity;
+    std::printf("%-12s %10.2f %10.2f %12.2f\n", "velocity", virtualCall(velocity, 1.0),
+                direct(BasicVelocitySystem<double>(), 1.0), stateSpace(makeVelocityStateSpace(), 1.0));
+
+    TemperatureSystem temperature;
+    std::printf("%-12s %10.2f %10.2f %12.2f\n", "temperature", virtualCall(temperature, 100.0),
+                direct(BasicTemperatureSystem<double>(), 100.0), stateSpace(makeTemperatureStateSpace(), 100.0));
+
+    // The state-space pendulum is the small-angle linearisation
+    InvertedPendulumSystem pendulum;
+    std::printf("%-12s %10.2f %10.2f %12.2f\n", "pendulum", virtualCall(pendulum, 0.0),
+                direct(BasicInvertedPendulumSystem<double>(), 0.0), stateSpace(makeLinearisedPendulumStateSpace(), 0.0));
+    return 0;
+}
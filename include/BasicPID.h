@@ -0,0 +1,250 @@
+#pragma once
+
+#include <algorithm>
+
+/// Compile-time building blocks for BasicPID. A policy bundles one choice from
+/// each group below; see PIDPolicy.
+namespace pid_policy
+{
+    // --- Output clamping --------------------------------------------------
+
+    /// Clamp the output to [outputMin, outputMax].
+    struct ClampOutput
+    {
+        template <typename Scalar>
+        static Scalar apply(Scalar output, Scalar outputMin, Scalar outputMax)
+        {
+            return std::clamp(output, outputMin, outputMax);
+        }
+    };
+
+    /// Pass the output through unchanged. The limits are ignored.
+    struct NoClamp
+    {
+        template <typename Scalar>
+        static Scalar apply(Scalar output, Scalar, Scalar)
+        {
+            return output;
+        }
+    };
+
+    // --- Anti-windup --------------------------------------------------------
+
+    /// While saturated only integrate error * (1 - antiWindupGain). This is PID's behaviour.
+    struct PartialIntegration
+    {
+        template <typename Scalar>
+        static Scalar integrate(Scalar cumulativeError, Scalar proposedCumulativeError, Scalar error,
+                                Scalar antiWindupGain, bool saturated)
+        {
+            if (saturated)
+                return cumulativeError + error * (Scalar(1.0) - antiWindupGain);
+            return proposedCumulativeError;
+        }
+    };
+
+    /// Freeze the integrator while saturated.
+    struct ConditionalIntegration
+    {
+        template <typename Scalar>
+        static Scalar integrate(Scalar cumulativeError, Scalar proposedCumulativeError, Scalar,
+                                Scalar, bool saturated)
+        {
+            return saturated ? cumulativeError : proposedCumulativeError;
+        }
+    };
+
+    /// Always integrate.
+    struct NoAntiWindup
+    {
+        template <typename Scalar>
+        static Scalar integrate(Scalar, Scalar proposedCumulativeError, Scalar, Scalar, bool)
+        {
+            return proposedCumulativeError;
+        }
+    };
+
+    // --- Derivative -----------------------------------------------------------
+
+    /// Kd * (error - previousError). This is PID's behaviour.
+    struct DerivativeOnError
+    {
+        template <typename Scalar>
+        static Scalar term(Scalar error, Scalar previousError, Scalar Kd)
+        {
+            return (error - previousError) * Kd;
+        }
+    };
+
+    /// PI controller: the derivative term is always zero.
+    struct NoDerivative
+    {
+        template <typename Scalar>
+        static Scalar term(Scalar, Scalar, Scalar)
+        {
+            return Scalar(0.0);
+        }
+    };
+
+    // --- Gains ------------------------------------------------------------------
+
+    /// Gains stored in the controller and settable at runtime.
+    struct RuntimeGains
+    {
+    };
+
+    /// Gains fixed at compile time. `G` provides `static constexpr double Kp, Ki, Kd`.
+    template <typename G>
+    struct FixedGains
+    {
+    };
+
+    template <typename Scalar, typename Source>
+    class GainStorage;
+
+    template <typename Scalar>
+    class GainStorage<Scalar, RuntimeGains>
+    {
+    public:
+        GainStorage() : GainStorage(Scalar(0.0), Scalar(0.0), Scalar(0.0)) {}
+        GainStorage(Scalar Kp, Scalar Ki, Scalar Kd) : m_Kp(Kp), m_Ki(Ki), m_Kd(Kd) {}
+
+        Scalar Kp() const { return m_Kp; }
+        Scalar Ki() const { return m_Ki; }
+        Scalar Kd() const { return m_Kd; }
+        void setKp(Scalar kp) { m_Kp = kp; }
+        void setKi(Scalar ki) { m_Ki = ki; }
+        void setKd(Scalar kd) { m_Kd = kd; }
+
+    private:
+        Scalar m_Kp;
+        Scalar m_Ki;
+        Scalar m_Kd;
+    };
+
+    template <typename Scalar, typename G>
+    class GainStorage<Scalar, FixedGains<G>>
+    {
+    public:
+        GainStorage() = default;
+
+        static constexpr Scalar Kp() { return Scalar(G::Kp); }
+        static constexpr Scalar Ki() { return Scalar(G::Ki); }
+        static constexpr Scalar Kd() { return Scalar(G::Kd); }
+    };
+}
+
+/// @brief A complete set of tuning parameters, applied to a controller as one unit.
+template <typename Scalar = double>
+struct PIDGains
+{
+    Scalar Kp;
+    Scalar Ki;
+    Scalar Kd;
+    Scalar antiWindupGain;
+    Scalar outputMin;
+    Scalar outputMax;
+};
+
+/// @brief Bundles the compile-time choices of a BasicPID.
+template <typename Clamp = pid_policy::ClampOutput,
+          typename AntiWindup = pid_policy::PartialIntegration,
+          typename Derivative = pid_policy::DerivativeOnError,
+          typename Gains = pid_policy::RuntimeGains>
+struct PIDPolicy
+{
+    using ClampPolicy = Clamp;
+    using AntiWindupPolicy = AntiWindup;
+    using DerivativePolicy = Derivative;
+    using GainSource = Gains;
+};
+
+/// @brief The policy matching PID: clamped output, partial integration while
+///        saturated, derivative on error and runtime gains.
+using DefaultPIDPolicy = PIDPolicy<>;
+
+/// @class BasicPID
+/// @brief Non-virtual PID controller whose behaviour is chosen at compile time.
+///
+/// With DefaultPIDPolicy and Scalar = double, control() performs exactly the
+/// same arithmetic as PID::control(), so the two can be swapped freely.
+template <typename Scalar = double, typename Policy = DefaultPIDPolicy>
+class BasicPID
+{
+    using Gains = pid_policy::GainStorage<Scalar, typename Policy::GainSource>;
+
+public:
+    BasicPID() : cumulativeError(0.0), previousError(0.0), antiWindupGain(1.0) {}
+
+    /// @note Only available with runtime gains.
+    BasicPID(Scalar Kp, Scalar Ki, Scalar Kd)
+        : gains(Kp, Ki, Kd), cumulativeError(0.0), previousError(0.0), antiWindupGain(1.0)
+    {
+    }
+
+    Scalar control(Scalar error)
+    {
+        Scalar P = error * gains.Kp();
+
+        // Store pre-clamped cumulativeError for backup
+        Scalar proposedCumulativeError = cumulativeError + error;
+        Scalar I = proposedCumulativeError * gains.Ki();
+
+        Scalar D = Policy::DerivativePolicy::term(error, previousError, gains.Kd());
+        previousError = error;
+
+        Scalar output = P + I + D;
+        Scalar clampedOutput = Policy::ClampPolicy::apply(output, outputMin, outputMax);
+
+        cumulativeError = Policy::AntiWindupPolicy::integrate(cumulativeError, proposedCumulativeError, error,
+                                                              antiWindupGain, output != clampedOutput);
+
+        return clampedOutput;
+    }
+
+    void setKp(Scalar kp) { gains.setKp(kp); }
+    void setKi(Scalar ki) { gains.setKi(ki); }
+    void setKd(Scalar kd) { gains.setKd(kd); }
+    void setAntiWindupGain(Scalar gain) { antiWindupGain = gain; }
+
+    void setOutputLimits(Scalar min, Scalar max)
+    {
+        outputMin = min;
+        outputMax = max;
+    }
+
+    void reset()
+    {
+        cumulativeError = Scalar(0.0);
+        previousError = Scalar(0.0);
+    }
+
+    Scalar Kp() const { return gains.Kp(); }
+    Scalar Ki() const { return gains.Ki(); }
+    Scalar Kd() const { return gains.Kd(); }
+
+    /// @brief Replaces gains, anti-windup gain and limits in one go. The controller state is kept.
+    void applyGains(const PIDGains<Scalar> &set)
+    {
+        gains.setKp(set.Kp);
+        gains.setKi(set.Ki);
+        gains.setKd(set.Kd);
+        antiWindupGain = set.antiWindupGain;
+        outputMin = set.outputMin;
+        outputMax = set.outputMax;
+    }
+
+    PIDGains<Scalar> gainSet() const
+    {
+        return {gains.Kp(), gains.Ki(), gains.Kd(), antiWindupGain, outputMin, outputMax};
+    }
+
+private:
+    Gains gains;
+    Scalar cumulativeError;
+    Scalar previousError;
+    Scalar antiWindupGain;
+
+    Scalar outputMin = Scalar(-100.0);
+    Scalar outputMax = Scalar(100.0);
+};
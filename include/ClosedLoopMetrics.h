@@ -0,0 +1,77 @@
+#pragma once
+
+#include "StepSample.h"
+#include <optional>
+
+/// @brief Thresholds of the step-response criteria.
+struct StepResponseSpec
+{
+    double riseLow = 0.1;       ///< Rise time starts when the output has covered this fraction of the step...
+    double riseHigh = 0.9;      ///< ...and ends when it has covered this one.
+    double settlingBand = 0.02; ///< Settled once |error| stays within this fraction of the step.
+};
+
+/// @class ClosedLoopMetrics
+/// @brief Step-response and integral criteria computed on the fly, in constant memory.
+///
+/// Feed it every StepSample of a run, e.g. as simulate()'s observer. Sample k
+/// is taken to be at time k * sampleTime. The step is measured from the first
+/// sample's output to its setpoint; a changing setpoint is tracked by the
+/// integral criteria but not by the step-response ones.
+class ClosedLoopMetrics
+{
+public:
+    explicit ClosedLoopMetrics(double sampleTime, const StepResponseSpec &spec = StepResponseSpec());
+
+    void operator()(const StepSample &sample);
+
+    /// @brief Forgets every sample seen so far.
+    void reset();
+
+    long long samples() const;
+
+    /// @brief Time from riseLow to riseHigh of the step; empty until the output got there.
+    std::optional<double> riseTime() const;
+
+    /// @brief Time after which |error| stayed inside the settling band; empty if it is outside now.
+    std::optional<double> settlingTime() const;
+
+    /// @brief Largest excursion past the setpoint, as a fraction of the step. 0 without overshoot.
+    double overshoot() const;
+
+    /// @brief Mean error since the output last entered the settling band,
+    ///        or the latest error if it is not settled.
+    double steadyStateError() const;
+
+    double iae() const;  ///< Integral of |error| dt.
+    double ise() const;  ///< Integral of error^2 dt.
+    double itae() const; ///< Integral of t |error| dt.
+
+    double controlEnergy() const;    ///< Integral of control^2 dt.
+    double controlVariation() const; ///< Sum of |control[k] - control[k-1]|, a measure of actuator wear.
+
+private:
+    double m_sampleTime;
+    StepResponseSpec m_spec;
+
+    long long m_samples = 0;
+    double m_initialOutput = 0.0;
+    double m_step = 0.0;
+
+    std::optional<double> m_riseLowTime;
+    std::optional<double> m_riseHighTime;
+    double m_overshoot = 0.0;
+
+    bool m_inBand = false;
+    double m_enteredBandTime = 0.0;
+    double m_errorSumInBand = 0.0;
+    long long m_samplesInBand = 0;
+    double m_lastError = 0.0;
+
+    double m_iae = 0.0;
+    double m_ise = 0.0;
+    double m_itae = 0.0;
+    double m_controlEnergy = 0.0;
+    double m_controlVariation = 0.0;
+    double m_lastControl = 0.0;
+};
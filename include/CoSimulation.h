@@ -0,0 +1,154 @@
+#pragma once
+
+#include "IPID.h"
+#include "IPlant.h"
+#include "StepSample.h"
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <vector>
+
+/// Simulated time in integer nanoseconds, so periods add up without rounding drift.
+using SimTime = int64_t;
+
+inline SimTime fromSeconds(double seconds)
+{
+    return static_cast<SimTime>(std::llround(seconds * 1e9));
+}
+
+inline double toSeconds(SimTime time)
+{
+    return static_cast<double>(time) * 1e-9;
+}
+
+/// @class EventScheduler
+/// @brief Discrete-event executor: runs timed tasks in time order.
+///
+/// Events at the same time run by ascending priority, then in the order they
+/// were scheduled, so a simulation is fully deterministic.
+class EventScheduler
+{
+public:
+    using Task = std::function<void()>;
+
+    /// @brief Runs `task` at `at` (no earlier than now()).
+    void schedule(SimTime at, Task task, int priority = 0);
+
+    /// @brief Runs `task` at `first`, `first + period`, ... until the scheduler stops.
+    void every(SimTime first, SimTime period, Task task, int priority = 0);
+
+    /// @brief Runs every event scheduled before `end`, then sets now() to `end`.
+    ///
+    /// Events exactly at `end` are left for the next call, so consecutive
+    /// calls cover adjacent half-open intervals.
+    void runUntil(SimTime end);
+
+    SimTime now() const;
+    size_t pending() const;
+    long long executed() const;
+
+private:
+    struct Event
+    {
+        SimTime time;
+        int priority;
+        uint64_t sequence;
+        SimTime period; // 0 for one-shot events
+        std::shared_ptr<Task> task;
+    };
+
+    struct Later
+    {
+        bool operator()(const Event &a, const Event &b) const
+        {
+            if (a.time != b.time)
+                return a.time > b.time;
+            if (a.priority != b.priority)
+                return a.priority > b.priority;
+            return a.sequence > b.sequence;
+        }
+    };
+
+    void push(SimTime at, SimTime period, std::shared_ptr<Task> task, int priority);
+
+    std::priority_queue<Event, std::vector<Event>, Later> m_queue;
+    SimTime m_now = 0;
+    uint64_t m_sequence = 0;
+    long long m_executed = 0;
+};
+
+/// @brief Rates and delays of one control loop.
+struct LoopTiming
+{
+    SimTime plantStep;           ///< Must equal the plant's own time step.
+    SimTime controlPeriod;       ///< Controller sampling period; any multiple of plantStep or not.
+    SimTime sensorLatency = 0;   ///< Sampling to the measurement reaching the controller.
+    SimTime actuatorLatency = 0; ///< Controller output to it acting on the plant.
+};
+
+/// @brief Event counts of one loop.
+struct LoopStats
+{
+    long long plantSteps = 0;
+    long long controlSamples = 0; ///< Measurements taken.
+    long long actuations = 0;     ///< Controller outputs applied to the plant.
+};
+
+/// @class CoSimulation
+/// @brief Multi-rate closed loops on an EventScheduler.
+///
+/// Each plant integrates at its own step while holding the last applied
+/// control signal (zero-order hold). Each controller samples its plant every
+/// control period; the measurement arrives after the sensor latency, the
+/// controller computes on arrival, and the result reaches the plant after the
+/// actuator latency. At equal times the order is: sample, compute, actuate,
+/// plant step, so a zero-latency loop with equal rates behaves like simulate().
+class CoSimulation
+{
+public:
+    /// Called on every controller computation. `output` is the delayed measurement,
+    /// `response` the plant's true output at that moment.
+    using Observer = std::function<void(const StepSample &)>;
+
+    CoSimulation() = default;
+
+    // Scheduled events capture `this`; a copy or a move would leave them pointing at the original
+    CoSimulation(const CoSimulation &) = delete;
+    CoSimulation &operator=(const CoSimulation &) = delete;
+
+    /// @return The loop's index. Plant and controller must outlive the simulation.
+    size_t addLoop(IPlant &plant, IPID &controller, double setpoint, const LoopTiming &timing,
+                   Observer observer = nullptr);
+
+    /// @brief Advances every loop by `duration`: events in [now(), now() + duration).
+    void run(SimTime duration);
+
+    SimTime now() const;
+    const LoopStats &stats(size_t loop) const;
+    EventScheduler &scheduler();
+
+private:
+    enum Priority
+    {
+        Sample,
+        Compute,
+        Actuate,
+        PlantStep
+    };
+
+    struct Loop
+    {
+        IPlant &plant;
+        IPID &controller;
+        double setpoint;
+        LoopTiming timing;
+        Observer observer;
+        double heldControl = 0.0;
+        LoopStats stats;
+    };
+
+    EventScheduler m_scheduler;
+    std::vector<std::unique_ptr<Loop>> m_loops;
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+/// @brief Philox4x32-10 block function (Salmon et al., "Parallel random numbers:
+///        as easy as 1, 2, 3"). Maps a 128-bit counter and a 64-bit key to 128
+///        statistically independent bits; no state is carried between calls.
+inline std::array<uint32_t, 4> philox4x32(std::array<uint32_t, 4> counter, std::array<uint32_t, 2> key)
+{
+    const uint32_t multiplier0 = 0xD2511F53, multiplier1 = 0xCD9E8D57;
+    const uint32_t weyl0 = 0x9E3779B9, weyl1 = 0xBB67AE85;
+
+    for (int round = 0; round < 10; ++round)
+    {
+        uint64_t product0 = static_cast<uint64_t>(multiplier0) * counter[0];
+        uint64_t product1 = static_cast<uint64_t>(multiplier1) * counter[2];
+        counter = {static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0], static_cast<uint32_t>(product1),
+                   static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1], static_cast<uint32_t>(product0)};
+        key[0] += weyl0;
+        key[1] += weyl1;
+    }
+    return counter;
+}
+
+/// @class CounterRng
+/// @brief Random stream addressed by (seed, stream index) instead of by a sequential state.
+///
+/// Draw n of stream s is philox(seed, s, n), so any stream can be generated on
+/// any thread, in any order, and gives the same numbers. Giving every Monte
+/// Carlo trial its own stream index makes results independent of scheduling.
+class CounterRng
+{
+public:
+    CounterRng(uint64_t seed, uint64_t stream)
+        : m_key{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)},
+          m_stream(stream)
+    {
+    }
+
+    /// @brief The next 64 random bits.
+    uint64_t next()
+    {
+        if (m_available == 0)
+        {
+            m_block = philox4x32({static_cast<uint32_t>(m_counter), static_cast<uint32_t>(m_counter >> 32),
+                                  static_cast<uint32_t>(m_stream), static_cast<uint32_t>(m_stream >> 32)},
+                                 m_key);
+            ++m_counter;
+            m_available = 2;
+        }
+        --m_available;
+        size_t word = m_available * 2;
+        return (static_cast<uint64_t>(m_block[word]) << 32) | m_block[word + 1];
+    }
+
+    /// @brief Uniform in [0, 1) with 53 random bits.
+    double uniform()
+    {
+        return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    /// @brief Uniform in [min, max).
+    double uniform(double min, double max)
+    {
+        return min + (max - min) * uniform();
+    }
+
+    /// @brief Normally distributed, by Box–Muller from two uniforms.
+    double normal(double mean, double stddev)
+    {
+        const double twoPi = 6.28318530717958647692;
+        double u1 = 1.0 - uniform(); // (0, 1], keeps the log finite
+        double u2 = uniform();
+        return mean + stddev * std::sqrt(-2.0 * std::log(u1)) * std::cos(twoPi * u2);
+    }
+
+private:
+    std::array<uint32_t, 2> m_key;
+    uint64_t m_stream;
+    uint64_t m_counter = 0;
+    std::array<uint32_t, 4> m_block{};
+    int m_available = 0;
+};
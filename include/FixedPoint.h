@@ -0,0 +1,181 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace fixed_point_detail
+{
+    template <typename Storage>
+    struct Wide;
+
+    template <>
+    struct Wide<int32_t>
+    {
+        using type = int64_t;
+    };
+
+    template <>
+    struct Wide<int64_t>
+    {
+        using type = __int128;
+    };
+}
+
+/// @class FixedPoint
+/// @brief Signed binary fixed-point number with `FracBits` fractional bits.
+///
+/// All arithmetic saturates at the representable range instead of wrapping,
+/// multiplication and division round to nearest, and division by zero
+/// saturates towards the sign of the dividend. Usable as the Scalar of
+/// BasicPID and the Basic*System plants.
+template <typename Storage, int FracBits>
+class FixedPoint
+{
+    static_assert(std::is_signed<Storage>::value, "FixedPoint needs a signed storage type");
+    static_assert(FracBits > 0 && FracBits < static_cast<int>(sizeof(Storage) * 8) - 1, "invalid number of fractional bits");
+
+    using Wide = typename fixed_point_detail::Wide<Storage>::type;
+
+public:
+    static constexpr int fractionalBits = FracBits;
+
+    constexpr FixedPoint() : m_raw(0) {}
+    constexpr explicit FixedPoint(int value) : m_raw(saturate(static_cast<Wide>(value) * (Wide(1) << FracBits))) {}
+    constexpr explicit FixedPoint(double value) : m_raw(fromDouble(value)) {}
+
+    /// @brief Builds a value from its raw two's complement representation.
+    static constexpr FixedPoint fromRaw(Storage raw)
+    {
+        FixedPoint result;
+        result.m_raw = raw;
+        return result;
+    }
+
+    static constexpr FixedPoint max() { return fromRaw(std::numeric_limits<Storage>::max()); }
+    static constexpr FixedPoint min() { return fromRaw(std::numeric_limits<Storage>::min()); }
+
+    /// @brief The smallest positive step, 2^-FracBits.
+    static constexpr double resolution() { return 1.0 / static_cast<double>(Wide(1) << FracBits); }
+
+    constexpr Storage raw() const { return m_raw; }
+
+    constexpr explicit operator double() const { return static_cast<double>(m_raw) * resolution(); }
+    constexpr explicit operator float() const { return static_cast<float>(static_cast<double>(*this)); }
+
+    constexpr FixedPoint operator-() const { return fromRaw(saturate(-static_cast<Wide>(m_raw))); }
+
+    friend constexpr FixedPoint operator+(FixedPoint a, FixedPoint b)
+    {
+        return fromRaw(saturate(static_cast<Wide>(a.m_raw) + b.m_raw));
+    }
+
+    friend constexpr FixedPoint operator-(FixedPoint a, FixedPoint b)
+    {
+        return fromRaw(saturate(static_cast<Wide>(a.m_raw) - b.m_raw));
+    }
+
+    friend constexpr FixedPoint operator*(FixedPoint a, FixedPoint b)
+    {
+        Wide product = static_cast<Wide>(a.m_raw) * b.m_raw;
+        // Round half away from zero before dropping the extra fractional bits
+        Wide half = Wide(1) << (FracBits - 1);
+        product = product >= 0 ? (product + half) >> FracBits : -((-product + half) >> FracBits);
+        return fromRaw(saturate(product));
+    }
+
+    friend constexpr FixedPoint operator/(FixedPoint a, FixedPoint b)
+    {
+        if (b.m_raw == 0)
+            return a.m_raw > 0 ? max() : (a.m_raw < 0 ? min() : FixedPoint());
+
+        Wide numerator = static_cast<Wide>(a.m_raw) * (Wide(1) << FracBits);
+        Wide denominator = b.m_raw;
+        Wide quotient = numerator / denominator;
+        Wide remainder = numerator % denominator;
+        // Round to nearest: compare twice the remainder against the divisor
+        if (2 * (remainder < 0 ? -remainder : remainder) >= (denominator < 0 ? -denominator : denominator))
+            quotient += ((numerator < 0) != (denominator < 0)) ? -1 : 1;
+        return fromRaw(saturate(quotient));
+    }
+
+    FixedPoint &operator+=(FixedPoint other) { return *this = *this + other; }
+    FixedPoint &operator-=(FixedPoint other) { return *this = *this - other; }
+    FixedPoint &operator*=(FixedPoint other) { return *this = *this * other; }
+    FixedPoint &operator/=(FixedPoint other) { return *this = *this / other; }
+
+    friend constexpr bool operator==(FixedPoint a, FixedPoint b) { return a.m_raw == b.m_raw; }
+    friend constexpr bool operator!=(FixedPoint a, FixedPoint b) { return a.m_raw != b.m_raw; }
+    friend constexpr bool operator<(FixedPoint a, FixedPoint b) { return a.m_raw < b.m_raw; }
+    friend constexpr bool operator>(FixedPoint a, FixedPoint b) { return a.m_raw > b.m_raw; }
+    friend constexpr bool operator<=(FixedPoint a, FixedPoint b) { return a.m_raw <= b.m_raw; }
+    friend constexpr bool operator>=(FixedPoint a, FixedPoint b) { return a.m_raw >= b.m_raw; }
+
+    friend constexpr FixedPoint abs(FixedPoint x) { return x.m_raw < 0 ? -x : x; }
+
+    /// @brief Sine in pure fixed-point arithmetic (no FPU needed).
+    ///
+    /// Reduces to [-pi/2, pi/2] and evaluates the Taylor series up to x^13,
+    /// which is accurate to ~1e-9 before rounding to the format's resolution.
+    friend FixedPoint sin(FixedPoint x)
+    {
+        const FixedPoint pi(3.14159265358979323846);
+        const FixedPoint halfPi(1.57079632679489661923);
+        const FixedPoint twoPi(6.28318530717958647692);
+
+        // Bring x into [-pi, pi] with an integer number of turns
+        FixedPoint turns = x / twoPi;
+        Storage wholeTurns = static_cast<Storage>((turns.m_raw + (Storage(1) << (FracBits - 1))) >> FracBits);
+        x = x - twoPi * FixedPoint(static_cast<Wide>(wholeTurns), 0);
+
+        if (x > halfPi)
+            x = pi - x;
+        else if (x < -halfPi)
+            x = -pi - x;
+
+        const FixedPoint one(1);
+        FixedPoint x2 = x * x;
+        FixedPoint series = one - x2 / FixedPoint(156);
+        series = one - x2 / FixedPoint(110) * series;
+        series = one - x2 / FixedPoint(72) * series;
+        series = one - x2 / FixedPoint(42) * series;
+        series = one - x2 / FixedPoint(20) * series;
+        series = one - x2 / FixedPoint(6) * series;
+        return x * series;
+    }
+
+private:
+    // Saturating conversion from an integer number of whole units
+    constexpr FixedPoint(Wide whole, int) : m_raw(saturate(whole * (Wide(1) << FracBits))) {}
+
+    static constexpr Storage saturate(Wide value)
+    {
+        if (value > static_cast<Wide>(std::numeric_limits<Storage>::max()))
+            return std::numeric_limits<Storage>::max();
+        if (value < static_cast<Wide>(std::numeric_limits<Storage>::min()))
+            return std::numeric_limits<Storage>::min();
+        return static_cast<Storage>(value);
+    }
+
+    static constexpr Storage fromDouble(double value)
+    {
+        if (value != value)
+            return 0;
+
+        double scaled = value * static_cast<double>(Wide(1) << FracBits);
+        if (scaled >= static_cast<double>(std::numeric_limits<Storage>::max()))
+            return std::numeric_limits<Storage>::max();
+        if (scaled <= static_cast<double>(std::numeric_limits<Storage>::min()))
+            return std::numeric_limits<Storage>::min();
+        return static_cast<Storage>(scaled >= 0.0 ? scaled + 0.5 : scaled - 0.5);
+    }
+
+    Storage m_raw;
+};
+
+/// Q16.16: 32-bit storage, range about ±32768, resolution 1.5e-5.
+using Q16_16 = FixedPoint<int32_t, 16>;
+
+/// Q32.32: 64-bit storage, range about ±2.1e9, resolution 2.3e-10.
+using Q32_32 = FixedPoint<int64_t, 32>;
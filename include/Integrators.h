@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+/// Integration scheme used by a plant to advance its state over one time step.
+enum class Integrator
+{
+    SemiImplicitEuler, ///< Velocity first, then position with the new velocity. The plants' original scheme.
+    ExplicitEuler,     ///< Both from the old state. First order and not symplectic.
+    RK4,               ///< Classic fourth-order Runge-Kutta, one step per update.
+    RK45               ///< Dormand–Prince 5(4) with adaptive substeps and error control.
+};
+
+/// Counters accumulated by a plant across update() calls.
+struct IntegrationStats
+{
+    long long steps = 0;                 ///< Accepted (sub)steps.
+    long long rejectedSteps = 0;         ///< RK45 steps retried with a smaller step size.
+    long long toleranceFailures = 0;     ///< RK45 updates that could not meet the tolerance; see rk45Integrate().
+    long long derivativeEvaluations = 0; ///< Calls of the right-hand side.
+    double lastErrorEstimate = 0.0;      ///< Local error estimate of the last accepted RK45 step.
+    double maxErrorEstimate = 0.0;       ///< Largest local error estimate accepted so far.
+};
+
+/// Tolerances of the RK45 step-size controller. A step is accepted when every
+/// component's error estimate is below absolute + relative * |state|.
+struct AdaptiveTolerance
+{
+    double absolute = 1e-9;
+    double relative = 1e-9;
+};
+
+/// Consecutive rejected RK45 steps after which rk45Integrate() stops controlling the error.
+constexpr int rk45MaxRejections = 50;
+
+namespace integrator_detail
+{
+    // x + h * (sum of weights[i] * k[i])
+    template <typename Scalar, size_t N, size_t K>
+    std::array<Scalar, N> combine(const std::array<Scalar, N> &x, Scalar h,
+                                  const std::array<double, K> &weights,
+                                  const std::array<std::array<Scalar, N>, K> &k, size_t used)
+    {
+        std::array<Scalar, N> result = x;
+        for (size_t n = 0; n < N; ++n)
+        {
+            Scalar sum(0.0);
+            for (size_t i = 0; i < used; ++i)
+                if (weights[i] != 0.0)
+                    sum += Scalar(weights[i]) * k[i][n];
+            result[n] += h * sum;
+        }
+        return result;
+    }
+}
+
+/// @brief One classic Runge–Kutta step of size h for dx/dt = f(x).
+template <typename Scalar, size_t N, typename F>
+void rk4Step(std::array<Scalar, N> &x, Scalar h, F &&f, IntegrationStats &stats)
+{
+    const Scalar half(0.5);
+    std::array<Scalar, N> k1 = f(x);
+    std::array<Scalar, N> tmp = x;
+    for (size_t n = 0; n < N; ++n)
+        tmp[n] = x[n] + half * h * k1[n];
+    std::array<Scalar, N> k2 = f(tmp);
+    for (size_t n = 0; n < N; ++n)
+        tmp[n] = x[n] + half * h * k2[n];
+    std::array<Scalar, N> k3 = f(tmp);
+    for (size_t n = 0; n < N; ++n)
+        tmp[n] = x[n] + h * k3[n];
+    std::array<Scalar, N> k4 = f(tmp);
+
+    for (size_t n = 0; n < N; ++n)
+        x[n] += h / Scalar(6.0) * (k1[n] + Scalar(2.0) * k2[n] + Scalar(2.0) * k3[n] + k4[n]);
+
+    stats.steps += 1;
+    stats.derivativeEvaluations += 4;
+}
+
+/// @brief Advances x by `duration` with adaptive Dormand–Prince 5(4) steps.
+///
+/// `stepSize` carries the controller's step size from one call to the next;
+/// pass 0 on the first call to start with a single step over the whole duration.
+///
+/// If the tolerance cannot be met (too tight for double precision, or a
+/// non-finite error estimate), the step size would shrink without bound. After
+/// rk45MaxRejections consecutive rejections, or once the step would fall below
+/// 16 ulp of the duration, the call counts a tolerance failure and finishes the
+/// duration with fixed steps of the size used before the rejections began.
+template <typename Scalar, size_t N, typename F>
+void rk45Integrate(std::array<Scalar, N> &x, double duration, F &&f, const AdaptiveTolerance &tolerance,
+                   double &stepSize, IntegrationStats &stats)
+{
+    using integrator_detail::combine;
+    using Stage = std::array<double, 7>;
+    static const std::array<Stage, 7> a = {{
+        {0, 0, 0, 0, 0, 0, 0},
+        {1.0 / 5, 0, 0, 0, 0, 0, 0},
+        {3.0 / 40, 9.0 / 40, 0, 0, 0, 0, 0},
+        {44.0 / 45, -56.0 / 15, 32.0 / 9, 0, 0, 0, 0},
+        {19372.0 / 6561, -25360.0 / 2187, 64448.0 / 6561, -212.0 / 729, 0, 0, 0},
+        {9017.0 / 3168, -355.0 / 33, 46732.0 / 5247, 49.0 / 176, -5103.0 / 18656, 0, 0},
+        {35.0 / 384, 0, 500.0 / 1113, 125.0 / 192, -2187.0 / 6784, 11.0 / 84, 0},
+    }};
+    // Fifth-order weights minus the embedded fourth-order ones
+    static const Stage errorWeights = {35.0 / 384 - 5179.0 / 57600, 0, 500.0 / 1113 - 7571.0 / 16695,
+                                       125.0 / 192 - 393.0 / 640, -2187.0 / 6784 + 92097.0 / 339200,
+                                       11.0 / 84 - 187.0 / 2100, -1.0 / 40};
+
+    if (!(stepSize > 0.0))
+        stepSize = duration;
+
+    // t never exceeds duration, so this is 16 ulp of max(|t|, duration)
+    const double minStep = 16.0 * std::numeric_limits<double>::epsilon() * duration;
+    int rejections = 0;
+    double lastGoodStep = stepSize;
+    bool uncontrolled = false;
+
+    double t = 0.0;
+    // Stop once the remainder is down to rounding noise of the accumulated time
+    while (duration - t > 1e-12 * duration)
+    {
+        double h = stepSize;
+        bool truncated = false;
+        if (h >= duration - t)
+        {
+            h = duration - t;
+            truncated = true;
+        }
+
+        std::array<std::array<Scalar, N>, 7> k;
+        k[0] = f(x);
+        for (size_t stage = 1; stage < 7; ++stage)
+            k[stage] = f(combine(x, Scalar(h), a[stage], k, stage));
+        stats.derivativeEvaluations += 7;
+
+        // The last stage is evaluated at the fifth-order solution
+        std::array<Scalar, N> candidate = combine(x, Scalar(h), a[6], k, 6);
+        std::array<Scalar, N> error = combine(std::array<Scalar, N>{}, Scalar(h), errorWeights, k, 7);
+
+        double ratio = 0.0, largest = 0.0;
+        for (size_t n = 0; n < N; ++n)
+        {
+            double e = std::fabs(static_cast<double>(error[n]));
+            double scale = tolerance.absolute + tolerance.relative * std::max(std::fabs(static_cast<double>(x[n])),
+                                                                               std::fabs(static_cast<double>(candidate[n])));
+            ratio = std::max(ratio, e / scale);
+            largest = std::max(largest, e);
+        }
+
+        bool accepted = ratio <= 1.0 || uncontrolled;
+        if (accepted)
+        {
+            x = candidate;
+            t += h;
+            stats.steps += 1;
+            stats.lastErrorEstimate = largest;
+            stats.maxErrorEstimate = std::max(stats.maxErrorEstimate, largest);
+            rejections = 0;
+        }
+        else
+        {
+            stats.rejectedSteps += 1;
+            ++rejections;
+        }
+
+        if (uncontrolled)
+            continue;
+
+        double factor = ratio == 0.0 ? 5.0 : std::clamp(0.9 * std::pow(ratio, -0.2), 0.2, 5.0);
+        double next = h * factor;
+        // Written so that a NaN ratio also ends up here
+        if (!accepted && (rejections >= rk45MaxRejections || !(next >= minStep)))
+        {
+            stats.toleranceFailures += 1;
+            uncontrolled = true;
+            stepSize = lastGoodStep;
+            continue;
+        }
+
+        // A step shortened to land on `duration` says nothing about the right step size
+        if (accepted && truncated)
+            stepSize = std::max(stepSize, next);
+        else
+            stepSize = next;
+        if (accepted)
+            lastGoodStep = stepSize;
+    }
+}
@@ -1,18 +1,123 @@
 #pragma once
 
 #include "IPlant.h"
+#include "Integrators.h"
+#include <array>
 #include <cmath>
 
-class InvertedPendulumSystem : public IPlant
+/// Pendulum driven by a torque, by default starting 0.1 rad from upright. Generic
+/// over the scalar type; `sin` is looked up by argument-dependent lookup so
+/// fixed-point types can provide their own.
+template <typename Scalar = double>
+class BasicInvertedPendulumSystem
+{
+public:
+    explicit BasicInvertedPendulumSystem(Scalar time_step = Scalar(0.01))
+        : BasicInvertedPendulumSystem(time_step, Scalar(1.0), Scalar(9.81), Scalar(1.0), Scalar(0.1)) {}
+
+    BasicInvertedPendulumSystem(Scalar time_step, Scalar inertia, Scalar gravity, Scalar length, Scalar initialAngle)
+        : angle_(initialAngle), angularVel_(0.0), time_step_(time_step),
+          inertia_(inertia), gravity_(gravity), length_(length) {}
+
+    Scalar update(Scalar controlSignal)
+    {
+        switch (integrator_)
+        {
+        case Integrator::SemiImplicitEuler:
+        {
+            angularVel_ += angularAcceleration(angle_, controlSignal) * time_step_;
+            angle_ += angularVel_ * time_step_;
+            stats_.steps += 1;
+            stats_.derivativeEvaluations += 1;
+            break;
+        }
+        case Integrator::ExplicitEuler:
+        {
+            Scalar angularAcc = angularAcceleration(angle_, controlSignal);
+            angle_ += angularVel_ * time_step_;
+            angularVel_ += angularAcc * time_step_;
+            stats_.steps += 1;
+            stats_.derivativeEvaluations += 1;
+            break;
+        }
+        case Integrator::RK4:
+        {
+            std::array<Scalar, 2> state = {angle_, angularVel_};
+            rk4Step(state, time_step_, derivative(controlSignal), stats_);
+            angle_ = state[0];
+            angularVel_ = state[1];
+            break;
+        }
+        case Integrator::RK45:
+        {
+            std::array<Scalar, 2> state = {angle_, angularVel_};
+            rk45Integrate(state, static_cast<double>(time_step_), derivative(controlSignal), tolerance_, adaptiveStep_, stats_);
+            angle_ = state[0];
+            angularVel_ = state[1];
+            break;
+        }
+        }
+
+        return angle_;
+    }
+
+    Scalar getOutput() const { return angle_; }
+
+    /// @brief Selects the integration scheme. The default is the original semi-implicit Euler.
+    void setIntegrator(Integrator integrator, AdaptiveTolerance tolerance = AdaptiveTolerance())
+    {
+        integrator_ = integrator;
+        tolerance_ = tolerance;
+        adaptiveStep_ = 0.0;
+    }
+
+    Integrator integrator() const { return integrator_; }
+    const IntegrationStats &integrationStats() const { return stats_; }
+
+private:
+    Scalar angularAcceleration(Scalar angle, Scalar controlSignal) const
+    {
+        using std::sin;
+
+        // Simplified dynamics: torque = controlSignal
+        Scalar torque = controlSignal;
+        return (torque - gravity_ * sin(angle) * length_) / inertia_;
+    }
+
+    // d/dt (angle, angularVel) under a torque held constant over the step
+    auto derivative(Scalar controlSignal) const
+    {
+        return [this, controlSignal](const std::array<Scalar, 2> &state)
+        {
+            return std::array<Scalar, 2>{state[1], angularAcceleration(state[0], controlSignal)};
+        };
+    }
+
+    Scalar angle_;      // radians
+    Scalar angularVel_; // rad/s
+    Scalar time_step_;
+    Scalar inertia_;
+    Scalar gravity_;
+    Scalar length_;
+
+    Integrator integrator_ = Integrator::SemiImplicitEuler;
+    AdaptiveTolerance tolerance_;
+    double adaptiveStep_ = 0.0; // RK45 step size carried between updates
+    IntegrationStats stats_;
+};
+
+class InvertedPendulumSystem final : public IPlant
 {
 public:
     explicit InvertedPendulumSystem(double time_step = 0.01);
+    InvertedPendulumSystem(double time_step, double inertia, double gravity, double length, double initialAngle);
 
     double update(double controlSignal) override;
     double getOutput() const override;
 
+    void setIntegrator(Integrator integrator, AdaptiveTolerance tolerance = AdaptiveTolerance());
+    const IntegrationStats &integrationStats() const;
+
 private:
-    double angle_;      // radians
-    double angularVel_; // rad/s
-    double time_step_;
+    BasicInvertedPendulumSystem<double> system_;
 };
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// @brief Summary of a LatencyHistogram at one moment. Values in nanoseconds.
+struct LatencySnapshot
+{
+    uint64_t count = 0;
+    uint64_t min = 0;
+    uint64_t max = 0;
+    double mean = 0.0;
+    uint64_t p50 = 0;
+    uint64_t p90 = 0;
+    uint64_t p99 = 0;
+    uint64_t p999 = 0;
+};
+
+/// @class LatencyHistogram
+/// @brief Lock-free log-linear histogram of durations in nanoseconds.
+///
+/// Values below 128 ns are counted exactly; above that every power of two is
+/// split into 128 linear buckets, so any recorded value is reproduced within
+/// 1/128 (< 0.8 %) of itself, up to about 39 hours. record() is a handful of
+/// relaxed atomic increments and may be called from any number of threads;
+/// readers see a slightly stale but consistent-enough view.
+class LatencyHistogram
+{
+public:
+    static constexpr int subBucketBits = 7;
+    static constexpr int maxExponent = 47;
+
+    LatencyHistogram();
+
+    void record(uint64_t nanoseconds);
+    void record(std::chrono::nanoseconds duration);
+
+    uint64_t count() const;
+    uint64_t min() const; ///< 0 when empty.
+    uint64_t max() const;
+    double mean() const;
+
+    /// @brief The smallest recorded bucket value below which `percentile` % of the samples lie.
+    /// @param percentile In [0, 100], e.g. 99.9.
+    uint64_t percentile(double percentile) const;
+
+    LatencySnapshot snapshot() const;
+
+    /// @brief Clears all counts. Not atomic with respect to concurrent record() calls.
+    void reset();
+
+    /// @brief Bucket index of a value, and the largest value sharing that bucket.
+    static size_t bucketOf(uint64_t nanoseconds);
+    static uint64_t highestEquivalentValue(size_t bucket);
+
+private:
+    static constexpr size_t subBucketCount = size_t(1) << subBucketBits;
+    static constexpr size_t bucketCount = subBucketCount + (maxExponent - subBucketBits + 1) * subBucketCount;
+
+    std::array<std::atomic<uint64_t>, bucketCount> m_buckets;
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<uint64_t> m_sum{0};
+    std::atomic<uint64_t> m_min;
+    std::atomic<uint64_t> m_max{0};
+};
+
+/// @brief One line: `name count=.. min=.. mean=.. p50=.. p90=.. p99=.. p99.9=.. max=..` (ns).
+void writeSnapshot(std::ostream &out, const std::string &name, const LatencySnapshot &snapshot);
+
+/// @class LatencyReporter
+/// @brief Writes snapshots of a set of histograms at a fixed interval from a background thread.
+class LatencyReporter
+{
+public:
+    /// @param out Must outlive the reporter; only the reporter thread writes to it while running.
+    LatencyReporter(std::ostream &out, std::chrono::milliseconds interval);
+
+    /// @brief Stops the thread after a final report.
+    ~LatencyReporter();
+
+    LatencyReporter(const LatencyReporter &) = delete;
+    LatencyReporter &operator=(const LatencyReporter &) = delete;
+
+    /// @brief Adds a histogram to the report. Call before start(); it must outlive the reporter.
+    void add(const std::string &name, const LatencyHistogram &histogram);
+
+    void start();
+
+    /// @brief Writes one last report and joins the thread.
+    void stop();
+
+    long long reports() const;
+
+private:
+    void report();
+
+    std::ostream &m_out;
+    std::chrono::milliseconds m_interval;
+    std::vector<std::pair<std::string, const LatencyHistogram *>> m_histograms;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_stopping = false;
+    std::atomic<long long> m_reports{0};
+    std::thread m_thread;
+};
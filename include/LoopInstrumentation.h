@@ -0,0 +1,133 @@
+#pragma once
+
+#include "LatencyHistogram.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/// The timed parts of one closed-loop step.
+enum class LoopPhase
+{
+    Control,     ///< Controller::control()
+    PlantUpdate, ///< Plant::update()
+    Observer     ///< The step observer (logging, metrics, ...)
+};
+
+/// @brief Time source reading std::chrono::steady_clock.
+struct SteadyClockSource
+{
+    using Stamp = std::chrono::steady_clock::time_point;
+
+    static Stamp now() { return std::chrono::steady_clock::now(); }
+
+    static void calibrate() {}
+
+    static uint64_t nanoseconds(Stamp from, Stamp to)
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count());
+    }
+};
+
+#if defined(__x86_64__) || defined(__i386__)
+/// @brief Time source reading the time-stamp counter: a few cycles per read
+///        instead of a clock_gettime call. Assumes an invariant TSC, as on any
+///        x86 CPU of the last decade; ticks are converted with a rate
+///        calibrated against steady_clock by calibrate().
+struct TscClockSource
+{
+    using Stamp = uint64_t;
+
+    static Stamp now() { return __rdtsc(); }
+
+    static uint64_t nanoseconds(Stamp from, Stamp to)
+    {
+        return static_cast<uint64_t>(static_cast<double>(to - from) * nanosecondsPerTick());
+    }
+
+    /// @brief Measures the tick rate once per process; it sleeps for 20 ms, so call it
+    ///        before a timed loop starts. LoopInstrumentation's constructor does.
+    static void calibrate();
+
+    /// @note Calibrates on first use if calibrate() was not called.
+    static double nanosecondsPerTick();
+};
+#endif
+
+/// @brief The default instrumentation policy: records nothing and compiles to nothing.
+struct NullInstrumentation
+{
+    struct Stamp
+    {
+    };
+
+    Stamp start() const { return {}; }
+    Stamp stop(LoopPhase, Stamp) const { return {}; }
+    void deadline(std::chrono::nanoseconds) const {}
+};
+
+/// @class LoopInstrumentation
+/// @brief Times every phase of a closed-loop step and how late each step resumed
+///        after its deadline, into one LatencyHistogram each.
+///
+/// Pass one to simulate() to enable it; the default NullInstrumentation keeps
+/// the loop free of any timing code.
+template <typename ClockSource = SteadyClockSource>
+class LoopInstrumentation
+{
+public:
+    using Stamp = typename ClockSource::Stamp;
+
+    /// @brief Calibrates the clock source up front, so the first stop() does not stall the loop.
+    LoopInstrumentation() { ClockSource::calibrate(); }
+
+    Stamp start() const { return ClockSource::now(); }
+
+    /// @brief Records the time since `since` under `phase`.
+    /// @return The end stamp, to chain straight into the next phase.
+    Stamp stop(LoopPhase phase, Stamp since)
+    {
+        Stamp end = ClockSource::now();
+        histogram(phase).record(ClockSource::nanoseconds(since, end));
+        return end;
+    }
+
+    /// @brief Records how late the loop resumed after a step's deadline.
+    void deadline(std::chrono::nanoseconds lateness) { m_wakeup.record(lateness); }
+
+    LatencyHistogram &histogram(LoopPhase phase)
+    {
+        switch (phase)
+        {
+        case LoopPhase::Control:
+            return m_control;
+        case LoopPhase::PlantUpdate:
+            return m_plantUpdate;
+        case LoopPhase::Observer:
+            break;
+        }
+        return m_observer;
+    }
+
+    const LatencyHistogram &control() const { return m_control; }
+    const LatencyHistogram &plantUpdate() const { return m_plantUpdate; }
+    const LatencyHistogram &observer() const { return m_observer; }
+    const LatencyHistogram &wakeup() const { return m_wakeup; }
+
+    /// @brief Registers all four histograms as `<prefix>.control`, `<prefix>.update`, ...
+    void addTo(LatencyReporter &reporter, const std::string &prefix) const
+    {
+        reporter.add(prefix + ".control", m_control);
+        reporter.add(prefix + ".update", m_plantUpdate);
+        reporter.add(prefix + ".observer", m_observer);
+        reporter.add(prefix + ".wakeup", m_wakeup);
+    }
+
+private:
+    LatencyHistogram m_control;
+    LatencyHistogram m_plantUpdate;
+    LatencyHistogram m_observer;
+    LatencyHistogram m_wakeup;
+};
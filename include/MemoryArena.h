@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+/// @class MonotonicArena
+/// @brief Bump allocator for short-lived objects, released in bulk.
+///
+/// Allocation advances a pointer through the current chunk; a request that
+/// does not fit starts a new chunk, each at least twice the size of the last,
+/// taken from the upstream resource. deallocate() does nothing: memory comes
+/// back only through release() or the destructor, so everything allocated
+/// from the arena must be done with by then. The first chunk may be a buffer
+/// supplied by the caller (e.g. on the stack), in which case a request that
+/// fits never touches the heap. Not thread-safe: use one arena per thread or
+/// per request.
+class MonotonicArena : public std::pmr::memory_resource
+{
+public:
+    explicit MonotonicArena(size_t initialChunkSize = 4096,
+                            std::pmr::memory_resource *upstream = std::pmr::new_delete_resource());
+
+    /// @brief Starts by carving allocations out of `buffer`, which must outlive the arena.
+    MonotonicArena(void *buffer, size_t size, std::pmr::memory_resource *upstream = std::pmr::new_delete_resource());
+
+    MonotonicArena(const MonotonicArena &) = delete;
+    MonotonicArena &operator=(const MonotonicArena &) = delete;
+
+    ~MonotonicArena() override;
+
+    /// @brief Returns every chunk to upstream and starts over from the initial buffer, if any,
+    ///        and from the initial chunk size, so a reused arena does not keep growing.
+    void release();
+
+    /// @brief Bytes handed out since construction or the last release(), including alignment padding.
+    size_t bytesUsed() const;
+
+    /// @brief Chunks currently obtained from upstream.
+    size_t chunkCount() const;
+
+private:
+    struct Chunk
+    {
+        Chunk *previous;
+        size_t size; ///< Bytes of the whole block, header included.
+    };
+
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+    void addChunk(size_t minimumBytes);
+
+    std::pmr::memory_resource *m_upstream;
+    void *m_initialBuffer = nullptr;
+    size_t m_initialSize = 0;
+    size_t m_initialChunkSize;
+    size_t m_nextChunkSize;
+    Chunk *m_chunks = nullptr;
+    char *m_current = nullptr;
+    size_t m_remaining = 0;
+    size_t m_used = 0;
+    size_t m_chunkCount = 0;
+};
+
+/// @brief This thread's pool resource: std::pmr::unsynchronized_pool_resource
+///        without locks, since only the calling thread ever uses it.
+///
+/// Memory from it must be freed on the same thread, before the thread exits;
+/// strings that outlive their thread or move to another must use a
+/// synchronized resource instead.
+std::pmr::memory_resource *threadLocalPool();
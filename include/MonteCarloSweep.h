@@ -0,0 +1,186 @@
+#pragma once
+
+#include "CounterRng.h"
+#include "IPlant.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/// @brief How one parameter is drawn for each trial.
+struct Distribution
+{
+    enum class Kind
+    {
+        Fixed,
+        Uniform,
+        Normal
+    };
+
+    Kind kind;
+    double a; ///< Value, minimum or mean.
+    double b; ///< Unused, maximum or standard deviation.
+
+    static Distribution fixed(double value) { return {Kind::Fixed, value, 0.0}; }
+    static Distribution uniform(double min, double max) { return {Kind::Uniform, min, max}; }
+    static Distribution normal(double mean, double stddev) { return {Kind::Normal, mean, stddev}; }
+
+    double sample(CounterRng &rng) const;
+};
+
+/// @brief The plant and controller parameters of one trial.
+struct TrialParameters
+{
+    double timeStep;
+    double inertia;
+    double length;
+    double initialAngle;
+    double Kp;
+    double Ki;
+    double Kd;
+};
+
+/// @brief The distributions trials are drawn from. Defaults: the stock pendulum
+///        under PID(1.0, 0.1, 0.05), with nothing varied.
+struct SweepSpace
+{
+    Distribution timeStep = Distribution::fixed(0.01);
+    Distribution inertia = Distribution::fixed(1.0);
+    Distribution length = Distribution::fixed(1.0);
+    Distribution initialAngle = Distribution::fixed(0.1);
+    Distribution Kp = Distribution::fixed(1.0);
+    Distribution Ki = Distribution::fixed(0.1);
+    Distribution Kd = Distribution::fixed(0.05);
+
+    /// @brief Draws every parameter, in declaration order.
+    TrialParameters sample(CounterRng &rng) const;
+};
+
+/// Builds a fresh plant for a trial; uses whichever parameters apply to it.
+using TrialPlantFactory = std::function<std::unique_ptr<IPlant>(const TrialParameters &)>;
+
+/// @brief InvertedPendulumSystem with the trial's time step, inertia, length and initial angle.
+TrialPlantFactory pendulumTrials();
+
+struct SweepProblem
+{
+    TrialPlantFactory makePlant = pendulumTrials();
+    SweepSpace space;
+    double setpoint = 0.0;
+    double duration = 5.0; ///< Simulated seconds per trial; the step count follows from the time step.
+    double outputMin = -100.0;
+    double outputMax = 100.0;
+};
+
+/// @brief Closed-loop criteria of one trial.
+struct TrialOutcome
+{
+    double iae;        ///< Integral of |error| dt.
+    double overshoot;  ///< Largest excursion past the setpoint, as a fraction of the initial error.
+    double finalError; ///< |error| at the end of the run.
+    bool stable;       ///< false if the output diverged or stopped being finite.
+};
+
+/// @brief Fixed-bin histogram over [min, max); values outside are counted separately.
+///        NaN, e.g. from a diverged trial, counts as overflow.
+class Histogram
+{
+public:
+    Histogram(double min = 0.0, double max = 1.0, size_t bins = 100);
+
+    void add(double value);
+    void merge(const Histogram &other);
+
+    /// @brief Approximate q-quantile, interpolated inside the bin it falls in.
+    ///        Clamped to [min, max] when it falls into the under- or overflow.
+    double quantile(double q) const;
+
+    double min() const { return m_min; }
+    double max() const { return m_max; }
+    const std::vector<long long> &bins() const { return m_bins; }
+    long long underflow() const { return m_underflow; }
+    long long overflow() const { return m_overflow; }
+    long long count() const;
+
+private:
+    double m_min;
+    double m_max;
+    std::vector<long long> m_bins;
+    long long m_underflow = 0;
+    long long m_overflow = 0;
+};
+
+/// @brief Moments, extremes and histogram of one criterion over many trials.
+class MetricSummary
+{
+public:
+    explicit MetricSummary(const Histogram &histogram = Histogram());
+
+    void add(double value);
+
+    /// @brief Chan et al.'s pairwise update, so partial summaries combine exactly as if
+    ///        the values had been added one by one (up to rounding).
+    void merge(const MetricSummary &other);
+
+    long long count() const { return m_count; }
+    double mean() const { return m_mean; }
+    double stddev() const;
+    double min() const { return m_min; }
+    double max() const { return m_max; }
+    const Histogram &histogram() const { return m_histogram; }
+
+private:
+    long long m_count = 0;
+    double m_mean = 0.0;
+    double m_m2 = 0.0; // sum of squared deviations from the mean
+    double m_min;
+    double m_max;
+    Histogram m_histogram;
+};
+
+struct SweepOptions
+{
+    uint64_t seed = 1;
+    long long trials = 100000;
+    long long chunkSize = 1024; ///< Trials per task. Part of the result's definition: keep it fixed to compare runs.
+    Histogram iaeHistogram = Histogram(0.0, 10.0, 200);
+    Histogram overshootHistogram = Histogram(0.0, 2.0, 200);
+    Histogram finalErrorHistogram = Histogram(0.0, 1.0, 200);
+};
+
+/// @brief Aggregated outcome of a sweep. The summaries cover stable trials only.
+struct SweepResult
+{
+    long long trials = 0;
+    long long unstable = 0;
+    MetricSummary iae;
+    MetricSummary overshoot;
+    MetricSummary finalError;
+};
+
+/// @class MonteCarloSweep
+/// @brief Runs many closed loops with randomly drawn parameters in parallel.
+///
+/// Trial i draws its parameters from CounterRng(seed, i), and trials are grouped
+/// into chunks of a fixed size whose partial results are merged in chunk order.
+/// Neither depends on the scheduling, so a sweep returns bit-identical results
+/// on any number of threads.
+class MonteCarloSweep
+{
+public:
+    MonteCarloSweep(SweepProblem problem, ThreadPool &pool);
+
+    /// @brief Runs options.trials trials and aggregates them.
+    SweepResult run(const SweepOptions &options = SweepOptions()) const;
+
+    /// @brief The parameters trial `index` of a sweep seeded with `seed` uses.
+    TrialParameters parameters(uint64_t seed, long long index) const;
+
+    /// @brief One closed loop through the IPlant / IPID interfaces.
+    TrialOutcome runTrial(const TrialParameters &parameters) const;
+
+private:
+    SweepProblem problem;
+    ThreadPool &pool;
+};
@@ -1,40 +1,113 @@
 #pragma once
+#include "MyStringTrace.h"
+#include "StringKernels.h"
+#include <atomic>
 #include <cstddef>
+#include <cstring>
+#include <memory_resource>
+#include <type_traits>
+
+template <typename Left, typename Right>
+class MyStringConcat;
 
 /// @class MyString
 /// @brief A simple string class that mimics basic string operations like copy, move,
 ///        concatenation, and comparison.
+///
+/// Strings of up to `inlineCapacity` characters are stored in a buffer inside
+/// the object (small-string optimization) and never touch the heap; longer ones
+/// are allocated with `new char[]`. `m_data` always points at the characters in
+/// use, so c_str() and size() cost the same either way.
+///
+/// Lifecycle events and heap allocations are reported to the MyStringTrace
+/// policy selected at compile time (see MyStringTrace.h): nothing by default,
+/// or process-wide counters read through stats().
+///
+/// `a + b + c` does not build intermediate strings: it yields a MyStringConcat
+/// expression that is materialized with a single allocation when assigned to a
+/// MyString. The result of `+` is therefore not itself a MyString: write
+/// `MyString s = a + b` rather than `auto s = a + b`, and `MyString(a + b).c_str()`
+/// to call members on it; `==` and `!=` accept an expression on either side.
+/// append() and operator+= grow the buffer geometrically, so building a string
+/// piece by piece is amortized O(1) per character.
+///
+/// Heap blocks come from a std::pmr::memory_resource, by default the one
+/// std::pmr::get_default_resource() returns when the string is created. Pass
+/// a MonotonicArena (see MemoryArena.h) to bump-allocate short-lived strings
+/// and free them in bulk. As with std::pmr::string, copies use the default
+/// resource unless one is given, a string keeps its resource for life, and
+/// std::pmr containers hand theirs to the MyStrings they hold.
+///
+/// Comparison and search use the SIMD kernels of StringKernels.h. hash() is
+/// computed on first use and cached in the object until the string changes,
+/// so a MyString used as an unordered_map key is hashed once.
 class MyString
 {
 public:
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+    /// @brief Returned by find() when there is no match.
+    static constexpr size_t npos = stringNpos;
+
+    /// @brief The longest string stored without a heap allocation.
+    static constexpr size_t inlineCapacity = 15;
+
+    /// @brief Whether this build counts events; stats() is all zeros otherwise.
+    static constexpr bool tracingEnabled = MyStringTrace::enabled;
+
+    /// @brief Counts of every MyString event since the last resetStats().
+    static MyStringStats stats();
+
+    /// @brief Zeroes the counters behind stats().
+    static void resetStats();
+
     /// @brief Default Constructor that initializes an empty string.
     MyString();
 
+    /// @brief Constructs an empty string that will allocate from `allocator`'s resource.
+    explicit MyString(const allocator_type &allocator);
+
     /// @brief Constructs a MyString object from a C-string.
     /// @param str A null-terminated C-string to initialize the MyString object.
-    MyString(const char *str);
+    /// @param allocator Source of heap storage, should the string not fit inline.
+    MyString(const char *str, const allocator_type &allocator = allocator_type());
+
+    /// @brief Materializes a concatenation expression with at most one allocation.
+    template <typename Left, typename Right>
+    MyString(const MyStringConcat<Left, Right> &expression, const allocator_type &allocator = allocator_type());
 
     /// @brief Copy Constructor that creates a deep copy of another MyString object.
     /// @param str The MyString object to copy from.
     MyString(const MyString &str);
 
+    /// @brief Deep copy that allocates from `allocator`'s resource.
+    MyString(const MyString &str, const allocator_type &allocator);
+
     /// @brief Move Constructor that transfers ownership of the resources from another MyString object.
-    /// @param str The MyString object to move from.
-    /// @note This operation is noexcept and should not throw exceptions.
+    /// @param str The MyString object to move from; left as an empty string.
+    /// @note This operation is noexcept and should not throw exceptions. Heap storage is
+    ///       handed over; inline characters are copied.
     MyString(MyString &&str) noexcept;
 
+    /// @brief Move that allocates from `allocator`'s resource; copies if it differs from `str`'s.
+    MyString(MyString &&str, const allocator_type &allocator);
+
     /// @brief Copy Assignment Operator that performs a deep copy of another MyString object.
     /// @param str The MyString object to assign.
     /// @return A reference to the current MyString object.
+    /// @note A heap block for the copy is allocated before the old storage is released;
+    ///       if that throws, this string is left unchanged.
     MyString &operator=(const MyString &str);
 
     /// @brief Move Assignment Operator that transfers ownership of the resources from another MyString object.
-    /// @param str The MyString object to move from.
+    /// @param str The MyString object to move from; left as an empty string.
     /// @return A reference to the current MyString object.
-    /// @note This operation is noexcept and should not throw exceptions.
-    MyString &operator=(MyString &&str) noexcept;
+    /// @note Heap storage is only handed over between equal memory resources; otherwise
+    ///       it is copied into a new block, which may throw (std::bad_alloc) and is why
+    ///       this is not noexcept. On a throw both strings are left unchanged.
+    MyString &operator=(MyString &&str);
 
-    /// @brief Destructor that deallocates the dynamically allocated memory.
+    /// @brief Destructor that deallocates the dynamically allocated memory, if any.
     ~MyString();
 
     /// @brief Accessor method to get the C-string representation of the string.
@@ -45,17 +118,245 @@ public:
     /// @return The size of the string.
     size_t size() const;
 
+    /// @brief Whether the characters live in the object's inline buffer.
+    bool isInline() const;
+
+    /// @brief The allocator wrapping this string's memory resource.
+    allocator_type get_allocator() const;
+
     /// @brief Equality comparison operator that compares two MyString objects.
     /// @param other The MyString object to compare with.
     /// @return true if both MyString objects are equal, false otherwise.
+    /// @note Strings whose cached hashes differ are told apart without reading their characters.
     bool operator==(const MyString &other) const;
 
-    /// @brief Concatenation operator that combines two MyString objects into a new MyString.
-    /// @param other The MyString object to concatenate with.
-    /// @return A new MyString that is the concatenation of the current object and `other`.
-    MyString operator+(const MyString &other) const;
+    bool operator!=(const MyString &other) const;
+
+    /// @brief Lexicographic comparison by unsigned character, a prefix sorting first.
+    /// @return Negative, zero or positive as this string sorts before, with or after `other`.
+    int compare(const MyString &other) const;
+
+    bool operator<(const MyString &other) const;
+
+    /// @brief Position of the first `c` at or after `pos`, or npos.
+    size_t find(char c, size_t pos = 0) const;
+
+    /// @brief Position of the first occurrence of `str` at or after `pos`, or npos.
+    size_t find(const char *str, size_t pos = 0) const;
+    size_t find(const MyString &str, size_t pos = 0) const;
+
+    /// @brief stringHash() of the characters, computed once and cached until the string changes.
+    size_t hash() const;
+
+    /// @brief Number of characters the current storage holds without reallocating.
+    size_t capacity() const;
+
+    /// @brief Makes room for at least `capacity` characters.
+    /// @note Grows to at least twice the current capacity, so repeated growth is amortized O(1).
+    void reserve(size_t capacity);
+
+    /// @brief Appends `count` characters from `str`, which may point into this string.
+    /// @return A reference to the current MyString object.
+    MyString &append(const char *str, size_t count);
+
+    /// @brief Appends a C-string.
+    MyString &append(const char *str);
+
+    /// @brief Appends another MyString (or this one).
+    MyString &append(const MyString &str);
+
+    /// @brief Appends a concatenation expression, evaluated straight into this string's buffer.
+    template <typename Left, typename Right>
+    MyString &append(const MyStringConcat<Left, Right> &expression);
+
+    /// @brief Same as append().
+    template <typename T>
+    MyString &operator+=(const T &str)
+    {
+        return append(str);
+    }
+
+private:
+    /// @brief Points m_data at storage for `size` characters plus the terminator.
+    /// @note Any previous heap storage must already have been released.
+    void allocate(size_t size);
+    void release();
+    void becomeEmpty();
+    void takeStorage(MyString &str);
+    size_t find(const char *str, size_t count, size_t pos) const;
+
+    /// @brief Moves the characters to storage for at least `capacity` characters.
+    void grow(size_t capacity);
+
+    /// @brief Copies `str`'s heap-sized characters into a new block, then releases the old storage.
+    /// @note Allocates before releasing anything: if the resource throws, this string is unchanged.
+    void assignToNewBlock(const MyString &str);
+
+    std::pmr::memory_resource *m_resource; ///< Where heap blocks come from.
+    char *m_data;                          ///< The characters: m_inline or a heap block.
+    size_t m_size;                         ///< The length (size) of the string.
+    size_t m_capacity;                     ///< Characters the heap block holds; unused when inline.
+    char m_inline[inlineCapacity + 1];     ///< Storage for short strings.
+
+    /// @brief hash(), or 0 when not computed yet. Relaxed atomic, so concurrent
+    ///        readers of a const string may all fill it in without a data race.
+    mutable std::atomic<size_t> m_hash;
+};
+
+/// @brief A C-string operand of a concatenation, measured once.
+struct MyStringLiteral
+{
+    const char *data;
+    size_t size;
+};
+
+/// @brief Types that can appear as operands of a MyString concatenation expression.
+template <typename T>
+struct IsMyStringOperand : std::false_type
+{
+};
+
+template <>
+struct IsMyStringOperand<MyString> : std::true_type
+{
+};
+
+template <typename Left, typename Right>
+struct IsMyStringOperand<MyStringConcat<Left, Right>> : std::true_type
+{
+};
+
+/// @class MyStringConcat
+/// @brief Lazy concatenation of two operands: MyStrings, C-strings or other expressions.
+///
+/// Nothing is copied until the expression is materialized (by MyString's
+/// converting constructor or append()), which first sums the operand sizes and
+/// then copies each operand once into the final buffer. MyString operands are
+/// held by reference, so an expression must not outlive them; assign it to a
+/// MyString within the same statement rather than keeping it in an `auto`.
+/// It has no string members of its own: materialize it first to call c_str().
+template <typename Left, typename Right>
+class MyStringConcat
+{
+public:
+    MyStringConcat(const Left &left, const Right &right)
+        : m_left(left), m_right(right), m_size(sizeOf(left) + sizeOf(right)) {}
+
+    size_t size() const { return m_size; }
+
+    /// @brief Copies the characters to `out` (without a terminator).
+    /// @return The position just past the last character written.
+    char *copyTo(char *out) const
+    {
+        return copy(m_right, copy(m_left, out));
+    }
 
 private:
-    char *m_data;  ///< Pointer to the dynamically allocated C-string data.
-    size_t m_size; ///< The length (size) of the string.
-};
\ No newline at end of file
+    // Nested expressions and literals are small values; strings are referenced
+    template <typename T>
+    using Stored = std::conditional_t<std::is_same<T, MyString>::value, const T &, T>;
+
+    static size_t sizeOf(const MyString &str) { return str.size(); }
+    static size_t sizeOf(const MyStringLiteral &str) { return str.size; }
+    template <typename L, typename R>
+    static size_t sizeOf(const MyStringConcat<L, R> &expression) { return expression.size(); }
+
+    static char *copy(const MyString &str, char *out)
+    {
+        std::memcpy(out, str.c_str(), str.size());
+        return out + str.size();
+    }
+    static char *copy(const MyStringLiteral &str, char *out)
+    {
+        std::memcpy(out, str.data, str.size);
+        return out + str.size;
+    }
+    template <typename L, typename R>
+    static char *copy(const MyStringConcat<L, R> &expression, char *out) { return expression.copyTo(out); }
+
+    Stored<Left> m_left;
+    Stored<Right> m_right;
+    size_t m_size;
+};
+
+/// @brief Concatenates two MyStrings or expressions lazily; see MyStringConcat.
+template <typename Left, typename Right,
+          typename = std::enable_if_t<IsMyStringOperand<Left>::value && IsMyStringOperand<Right>::value>>
+MyStringConcat<Left, Right> operator+(const Left &left, const Right &right)
+{
+    return MyStringConcat<Left, Right>(left, right);
+}
+
+template <typename Left, typename = std::enable_if_t<IsMyStringOperand<Left>::value>>
+MyStringConcat<Left, MyStringLiteral> operator+(const Left &left, const char *right)
+{
+    return MyStringConcat<Left, MyStringLiteral>(left, MyStringLiteral{right, std::strlen(right)});
+}
+
+template <typename Right, typename = std::enable_if_t<IsMyStringOperand<Right>::value>>
+MyStringConcat<MyStringLiteral, Right> operator+(const char *left, const Right &right)
+{
+    return MyStringConcat<MyStringLiteral, Right>(MyStringLiteral{left, std::strlen(left)}, right);
+}
+
+/// @brief Compares an expression with a string by materializing it.
+template <typename Left, typename Right>
+bool operator==(const MyStringConcat<Left, Right> &left, const MyString &right)
+{
+    return left.size() == right.size() && MyString(left) == right;
+}
+
+template <typename Left, typename Right>
+bool operator==(const MyString &left, const MyStringConcat<Left, Right> &right)
+{
+    return right == left;
+}
+
+template <typename Left, typename Right>
+bool operator!=(const MyStringConcat<Left, Right> &left, const MyString &right)
+{
+    return !(left == right);
+}
+
+template <typename Left, typename Right>
+bool operator!=(const MyString &left, const MyStringConcat<Left, Right> &right)
+{
+    return !(right == left);
+}
+
+template <typename Left, typename Right>
+MyString::MyString(const MyStringConcat<Left, Right> &expression, const allocator_type &allocator)
+    : m_resource(allocator.resource()), m_hash(0)
+{
+    MyStringTrace::event(MyStringEvent::Construction, "[Constructor from concatenation]");
+    allocate(expression.size());
+    expression.copyTo(m_data);
+    m_data[m_size] = '\0';
+}
+
+template <typename Left, typename Right>
+MyString &MyString::append(const MyStringConcat<Left, Right> &expression)
+{
+    size_t newSize = m_size + expression.size();
+    reserve(newSize);
+    // The expression may read this string: its old characters are left untouched
+    // and the size is only updated once everything has been copied
+    expression.copyTo(m_data + m_size);
+    m_size = newSize;
+    m_data[m_size] = '\0';
+    m_hash.store(0, std::memory_order_relaxed);
+    return *this;
+}
+
+/// @brief Hashes MyStrings with their cached MyString::hash(), for unordered containers.
+namespace std
+{
+    template <>
+    struct hash<MyString>
+    {
+        size_t operator()(const MyString &str) const noexcept
+        {
+            return str.hash();
+        }
+    };
+}
@@ -0,0 +1,131 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <iostream>
+
+/// @brief Lifecycle and allocation counts of every MyString in the process.
+struct MyStringStats
+{
+    long long constructions = 0;  ///< Default, C-string and concatenation results.
+    long long copies = 0;         ///< Copy constructions and copy assignments.
+    long long moves = 0;          ///< Move constructions and move assignments.
+    long long destructions = 0;
+    long long allocations = 0;    ///< Heap blocks obtained; inline strings allocate none.
+    long long deallocations = 0;
+    long long bytesAllocated = 0;
+};
+
+/// @brief The lifecycle events a trace policy is told about.
+enum class MyStringEvent
+{
+    Construction,
+    Copy,
+    Move,
+    Destruction
+};
+
+/// @class NullStringTrace
+/// @brief The default policy: every hook is empty and compiles away.
+struct NullStringTrace
+{
+    static constexpr bool enabled = false;
+
+    static void event(MyStringEvent, const char *) {}
+    static void allocation(size_t) {}
+    static void deallocation() {}
+    static MyStringStats stats() { return MyStringStats(); }
+    static void reset() {}
+};
+
+/// @class CountingStringTrace
+/// @brief Counts events and allocations with relaxed atomics; safe across threads.
+struct CountingStringTrace
+{
+    static constexpr bool enabled = true;
+
+    static void event(MyStringEvent what, const char *)
+    {
+        switch (what)
+        {
+        case MyStringEvent::Construction:
+            s_constructions.fetch_add(1, std::memory_order_relaxed);
+            break;
+        case MyStringEvent::Copy:
+            s_copies.fetch_add(1, std::memory_order_relaxed);
+            break;
+        case MyStringEvent::Move:
+            s_moves.fetch_add(1, std::memory_order_relaxed);
+            break;
+        case MyStringEvent::Destruction:
+            s_destructions.fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+    }
+
+    static void allocation(size_t bytes)
+    {
+        s_allocations.fetch_add(1, std::memory_order_relaxed);
+        s_bytesAllocated.fetch_add(static_cast<long long>(bytes), std::memory_order_relaxed);
+    }
+
+    static void deallocation()
+    {
+        s_deallocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static MyStringStats stats()
+    {
+        MyStringStats result;
+        result.constructions = s_constructions.load(std::memory_order_relaxed);
+        result.copies = s_copies.load(std::memory_order_relaxed);
+        result.moves = s_moves.load(std::memory_order_relaxed);
+        result.destructions = s_destructions.load(std::memory_order_relaxed);
+        result.allocations = s_allocations.load(std::memory_order_relaxed);
+        result.deallocations = s_deallocations.load(std::memory_order_relaxed);
+        result.bytesAllocated = s_bytesAllocated.load(std::memory_order_relaxed);
+        return result;
+    }
+
+    static void reset()
+    {
+        for (std::atomic<long long> *counter : {&s_constructions, &s_copies, &s_moves, &s_destructions,
+                                                &s_allocations, &s_deallocations, &s_bytesAllocated})
+            counter->store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static inline std::atomic<long long> s_constructions{0};
+    static inline std::atomic<long long> s_copies{0};
+    static inline std::atomic<long long> s_moves{0};
+    static inline std::atomic<long long> s_destructions{0};
+    static inline std::atomic<long long> s_allocations{0};
+    static inline std::atomic<long long> s_deallocations{0};
+    static inline std::atomic<long long> s_bytesAllocated{0};
+};
+
+/// @class ConsoleStringTrace
+/// @brief Counts like CountingStringTrace and also prints each event to std::cout,
+///        as MyString originally did. For debugging only: it is slow.
+struct ConsoleStringTrace : CountingStringTrace
+{
+    static void event(MyStringEvent what, const char *label)
+    {
+        CountingStringTrace::event(what, label);
+        std::cout << label << '\n';
+    }
+};
+
+/// @brief The policy MyString is built with, chosen by the MYSTRING_TRACE macro:
+///        0 (default) no tracing, 1 counters, 2 counters and console output.
+/// @note The macro must be the same for every translation unit that includes MyString.h.
+#ifndef MYSTRING_TRACE
+#define MYSTRING_TRACE 0
+#endif
+
+#if MYSTRING_TRACE == 2
+using MyStringTrace = ConsoleStringTrace;
+#elif MYSTRING_TRACE == 1
+using MyStringTrace = CountingStringTrace;
+#else
+using MyStringTrace = NullStringTrace;
+#endif
@@ -1,5 +1,16 @@
+#pragma once
+
 #include "IPID.h"
+#include "BasicPID.h"
+#include "TripleBuffer.h"
 
+/// Virtual IPID adapter over BasicPID<double>. Use BasicPID directly where the
+/// controller type is known at compile time.
+///
+/// The setters are meant for the thread calling control(). Another thread (one
+/// at a time) may retune the running loop with publishGains(): the whole set is
+/// picked up atomically at the start of the next control() call, which never
+/// blocks.
 class PID : public IPID
 {
 public:
@@ -15,14 +26,13 @@ public:
     void setAntiWindupGain(double gain);
     void setOutputLimits(double min, double max);
 
-private:
-    double Kp;
-    double Ki;
-    double Kd;
-    double cumulativeError;
-    double previousError;
-    double antiWindupGain;
+    /// @brief Publishes a complete gain/limit set from a tuning thread. Wait-free.
+    void publishGains(const PIDGains<double> &gains);
 
-    double outputMin = -100.0;
-    double outputMax = 100.0;
+    /// @brief The set currently used by control(). Control thread only.
+    PIDGains<double> gains() const;
+
+private:
+    BasicPID<double> impl;
+    TripleBuffer<PIDGains<double>> pendingGains;
 };
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "IPlant.h"
+#include "ThreadPool.h"
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+/// Creates a fresh plant in its initial state for every closed-loop run.
+using PlantFactory = std::function<std::unique_ptr<IPlant>()>;
+
+/// @brief The closed loop a set of gains is scored on.
+struct TuningProblem
+{
+    PlantFactory makePlant;
+    double setpoint = 1.0;
+    int steps = 200;
+    double sampleTime = 0.1; ///< Plant time step, used for ITAE and the Ziegler–Nichols conversion.
+    double outputMin = -100.0;
+    double outputMax = 100.0;
+};
+
+/// @brief Weights of the individual criteria in the scalar cost.
+struct CostWeights
+{
+    double iae = 1.0;
+    double itae = 0.0;
+    double overshoot = 0.0; ///< Applied to the overshoot fraction (0.2 = 20 %).
+};
+
+struct GainCandidate
+{
+    double Kp;
+    double Ki;
+    double Kd;
+};
+
+struct LoopScore
+{
+    double iae;       ///< Integral of |error| dt.
+    double itae;      ///< Integral of t * |error| dt.
+    double overshoot; ///< Largest excursion past the setpoint, as a fraction of the step.
+    double cost;      ///< Weighted sum; very large when the loop diverges.
+    bool stable;
+};
+
+struct TuningResult
+{
+    GainCandidate gains;
+    LoopScore score;
+    size_t evaluations;
+};
+
+/// @brief Inclusive range sampled at `count` evenly spaced points.
+struct GainRange
+{
+    double min;
+    double max;
+    size_t count;
+};
+
+/// @brief Ultimate gain and period measured with a relay feedback experiment.
+struct RelayResult
+{
+    double ultimateGain;
+    double ultimatePeriod; ///< Seconds.
+};
+
+struct NelderMeadOptions
+{
+    int maxIterations = 100;
+    double tolerance = 1e-6;  ///< Stop when the spread of the simplex costs drops below this.
+    double initialStep = 0.5; ///< Relative size of the initial simplex around the start point.
+};
+
+/// @class PIDAutoTuner
+/// @brief Searches PID gain space by scoring closed-loop runs on any IPlant.
+///
+/// Candidate evaluations are independent runs on fresh plants, so they are
+/// spread across the thread pool: a grid is evaluated all at once, and each
+/// Nelder–Mead iteration evaluates its reflection, expansion and contraction
+/// points speculatively in parallel.
+class PIDAutoTuner
+{
+public:
+    PIDAutoTuner(TuningProblem problem, ThreadPool &pool, CostWeights weights = CostWeights());
+
+    /// @brief Scores one set of gains on a fresh plant.
+    LoopScore evaluate(const GainCandidate &gains) const;
+
+    /// @brief Scores all candidates in parallel. Results keep the input order.
+    std::vector<LoopScore> evaluateAll(const std::vector<GainCandidate> &candidates);
+
+    /// @brief Exhaustive search over the cartesian product of the three ranges.
+    TuningResult gridSearch(const GainRange &kp, const GainRange &ki, const GainRange &kd);
+
+    /// @brief Local refinement from `start`. Gains are kept non-negative.
+    TuningResult nelderMead(const GainCandidate &start, const NelderMeadOptions &options = NelderMeadOptions());
+
+    /// @brief Drives the plant with a relay of amplitude `relayAmplitude` around the setpoint.
+    /// @return Nothing if no sustained oscillation was observed.
+    std::optional<RelayResult> relayExperiment(double relayAmplitude, int steps) const;
+
+    /// @brief Classic Ziegler–Nichols PID rule converted to this PID's discrete gains.
+    GainCandidate zieglerNichols(const RelayResult &relay) const;
+
+    /// @brief Nelder–Mead started from the better of a relay/Ziegler–Nichols seed
+    ///        and a coarse grid.
+    TuningResult tune(double relayAmplitude = 1.0);
+
+    size_t evaluations() const;
+
+private:
+    TuningProblem problem;
+    CostWeights weights;
+    ThreadPool &pool;
+    size_t evaluationCount = 0;
+};
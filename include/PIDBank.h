@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/// @class PIDBank
+/// @brief A bank of independent PID loops stored as structure-of-arrays and
+///        evaluated a whole batch at a time.
+///
+/// Every lane reproduces PID::control() bit for bit: the same operations are
+/// performed in the same order, the clamp and the anti-windup branch are
+/// computed as masked blends, and no fused multiply-add is used.
+class PIDBank
+{
+public:
+    /// @brief Instruction set used to evaluate the loops.
+    enum class Kernel
+    {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+
+    /// @brief Creates an empty bank using the best kernel the CPU supports.
+    PIDBank();
+
+    /// @brief Creates a bank of `count` loops sharing the same gains.
+    PIDBank(size_t count, double Kp, double Ki, double Kd);
+
+    /// @brief Appends a loop with the default PID state and output limits.
+    /// @return The index of the new loop.
+    size_t addLoop(double Kp, double Ki, double Kd);
+
+    /// @brief Returns the number of loops in the bank.
+    size_t size() const;
+
+    void setKp(size_t loop, double kp);
+    void setKi(size_t loop, double ki);
+    void setKd(size_t loop, double kd);
+    void setAntiWindupGain(size_t loop, double gain);
+    void setOutputLimits(size_t loop, double min, double max);
+
+    /// @brief Clears the integrator and derivative memory of every loop.
+    void reset();
+
+    /// @brief Clears the integrator and derivative memory of a single loop.
+    void reset(size_t loop);
+
+    /// @brief Runs one control step for every loop.
+    /// @param errors `size()` errors, one per loop.
+    /// @param outputs Receives `size()` clamped control outputs.
+    void control(const double *errors, double *outputs);
+
+    /// @brief Runs one control step for loops [first, first + count).
+    void control(size_t first, size_t count, const double *errors, double *outputs);
+
+    /// @brief Selects the kernel. Kernels the CPU cannot run fall back to the best supported one.
+    void setKernel(Kernel kernel);
+    Kernel kernel() const;
+
+    /// @brief Returns the widest kernel supported by the running CPU.
+    static Kernel bestKernel();
+
+    double cumulativeError(size_t loop) const;
+    double previousError(size_t loop) const;
+
+private:
+    std::vector<double> m_Kp;
+    std::vector<double> m_Ki;
+    std::vector<double> m_Kd;
+    std::vector<double> m_cumulativeError;
+    std::vector<double> m_previousError;
+    std::vector<double> m_antiWindupGain;
+    std::vector<double> m_outputMin;
+    std::vector<double> m_outputMax;
+
+    Kernel m_kernel;
+};
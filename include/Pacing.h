@@ -0,0 +1,71 @@
+#pragma once
+
+#include <chrono>
+
+/// @brief How fast a simulation loop advances relative to wall-clock time.
+class Pacing
+{
+public:
+    /// @brief No waiting at all: steps run back to back.
+    static Pacing unthrottled(double samplingPeriod = 0.05);
+
+    /// @brief One step per sampling period of wall-clock time.
+    static Pacing realtime(double samplingPeriod = 0.05);
+
+    /// @brief `factor` steps per sampling period of wall-clock time.
+    static Pacing accelerated(double factor, double samplingPeriod = 0.05);
+
+    /// @brief Simulated seconds per step.
+    double samplingPeriod() const;
+
+    /// @brief Wall-clock time between step deadlines; zero when unthrottled.
+    std::chrono::nanoseconds wallPeriod() const;
+
+    bool throttled() const;
+
+private:
+    Pacing(double samplingPeriod, double speedup);
+
+    double m_samplingPeriod;
+    double m_speedup; ///< 0 means unthrottled.
+};
+
+/// @brief Overrun accounting of a Pacer.
+struct PacingStats
+{
+    long long steps = 0;
+    long long overruns = 0;                       ///< Steps whose work finished after their deadline.
+    std::chrono::nanoseconds maxOverrun{0};       ///< Worst amount by which a deadline was missed.
+    std::chrono::nanoseconds maxWakeupLatency{0}; ///< Worst delay between a deadline and the actual wake-up.
+};
+
+/// @class Pacer
+/// @brief Drift-free absolute-deadline scheduler for a stepped loop.
+///
+/// Step k's deadline is start + (k + 1) * period, computed from the fixed start
+/// time rather than by adding up relative sleeps, so neither the loop body nor
+/// sleep overshoot accumulates into drift. A step that overruns its deadline
+/// is counted and the next step starts immediately; the schedule catches up
+/// instead of shifting.
+class Pacer
+{
+public:
+    explicit Pacer(const Pacing &pacing);
+
+    /// @brief Sets the schedule's epoch to now. Called by the constructor.
+    void restart();
+
+    /// @brief Blocks until the deadline of the step just completed.
+    /// @return How late the loop resumes relative to that deadline: the wake-up
+    ///         latency, or the overrun when the deadline had already passed. Zero when unthrottled.
+    std::chrono::nanoseconds waitForNextStep();
+
+    const PacingStats &stats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Pacing m_pacing;
+    Clock::time_point m_start;
+    PacingStats m_stats;
+};
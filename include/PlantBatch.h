@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Structure-of-arrays versions of the plants that step N independent instances
+// per call, e.g. for Monte Carlo runs over perturbed parameters. Every lane
+// performs the same operations in the same order as the single-instance class,
+// so the linear plants match it bit for bit. The pendulum uses polySin()
+// instead of std::sin and stays within a few ulp per step.
+
+class PositionSystemBatch
+{
+public:
+    explicit PositionSystemBatch(size_t count, double time_step = 0.1);
+
+    /// @param controlSignals One control signal per instance.
+    void update(const double *controlSignals);
+
+    size_t size() const;
+    const double *outputs() const;
+    double getOutput(size_t i) const;
+
+    void setTimeStep(size_t i, double time_step);
+    void setState(size_t i, double position, double velocity);
+
+private:
+    std::vector<double> position_;
+    std::vector<double> velocity_;
+    std::vector<double> time_step_;
+};
+
+class VelocitySystemBatch
+{
+public:
+    explicit VelocitySystemBatch(size_t count, double time_step = 0.1);
+
+    void update(const double *controlSignals);
+
+    size_t size() const;
+    const double *outputs() const;
+    double getOutput(size_t i) const;
+
+    void setTimeStep(size_t i, double time_step);
+    void setState(size_t i, double velocity);
+
+private:
+    std::vector<double> velocity_;
+    std::vector<double> time_step_;
+};
+
+class TemperatureSystemBatch
+{
+public:
+    explicit TemperatureSystemBatch(size_t count, double time_step = 0.1);
+
+    void update(const double *controlSignals);
+
+    size_t size() const;
+    const double *outputs() const;
+    double getOutput(size_t i) const;
+
+    void setTimeStep(size_t i, double time_step);
+    void setState(size_t i, double temperature);
+
+private:
+    std::vector<double> temperature_;
+    std::vector<double> time_step_;
+};
+
+class InvertedPendulumSystemBatch
+{
+public:
+    explicit InvertedPendulumSystemBatch(size_t count, double time_step = 0.01);
+
+    void update(const double *controlSignals);
+
+    size_t size() const;
+    const double *outputs() const;
+    double getOutput(size_t i) const;
+
+    void setTimeStep(size_t i, double time_step);
+    void setState(size_t i, double angle, double angularVel);
+    /// @brief Physical parameters; the defaults match InvertedPendulumSystem.
+    void setParameters(size_t i, double inertia, double gravity, double length);
+
+private:
+    std::vector<double> angle_;
+    std::vector<double> angularVel_;
+    std::vector<double> time_step_;
+    std::vector<double> inertia_;
+    std::vector<double> gravity_;
+    std::vector<double> length_;
+    std::vector<double> sinAngle_; // scratch for the vectorised sine
+};
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/// @brief A point in data coordinates (x: step or time, y: signal value).
+struct PlotPoint
+{
+    float x;
+    float y;
+};
+
+/// @class PlotRing
+/// @brief Fixed-capacity ring of plot points that remembers which slots changed.
+///
+/// A renderer mirrors the ring's storage in a vertex buffer and, once per
+/// frame, uploads only the slots written since the previous frame (see
+/// takeDirty()). When full, the oldest point is overwritten.
+class PlotRing
+{
+public:
+    explicit PlotRing(size_t capacity);
+
+    void push(PlotPoint point);
+    void clear();
+
+    size_t size() const;
+    size_t capacity() const;
+
+    /// @brief The i-th oldest point.
+    const PlotPoint &operator[](size_t i) const;
+
+    /// @brief Storage index of the oldest point; the points run from here to the
+    ///        end of storage and continue from slot 0.
+    size_t head() const;
+
+    /// @brief Raw storage, `capacity()` slots (of which `size()` are in use).
+    const PlotPoint *data() const;
+
+    /// @brief Calls upload(firstSlot, count) for the storage written since the
+    ///        last call (twice if that range wraps around), then forgets it.
+    template <typename Upload>
+    void takeDirty(Upload &&upload)
+    {
+        if (m_dirtyCount == 0)
+            return;
+        size_t first = m_dirtyFirst, count = m_dirtyCount;
+        size_t tail = m_points.size() - first;
+        if (count <= tail)
+            upload(first, count);
+        else
+        {
+            upload(first, tail);
+            upload(size_t(0), count - tail);
+        }
+        m_dirtyCount = 0;
+    }
+
+    /// @brief Vertical extent of the points currently held; {0, 0} when empty.
+    float minY() const;
+    float maxY() const;
+
+private:
+    void recomputeBounds() const;
+
+    std::vector<PlotPoint> m_points;
+    size_t m_head = 0;
+    size_t m_size = 0;
+    size_t m_dirtyFirst = 0;
+    size_t m_dirtyCount = 0;
+
+    // Bounds are updated on push and recomputed lazily once an extreme is evicted
+    mutable float m_minY = 0.0f;
+    mutable float m_maxY = 0.0f;
+    mutable bool m_boundsStale = false;
+};
+
+/// @class MinMaxDecimator
+/// @brief Streaming min/max decimation: keeps the extremes of each column.
+///
+/// Samples are grouped into columns `columnWidth` wide along x (one per pixel,
+/// typically). When a sample opens a new column, the finished column is
+/// emitted as its minimum and maximum, in the order they occurred, so peaks
+/// survive however many samples share a pixel. At most two points per column.
+class MinMaxDecimator
+{
+public:
+    explicit MinMaxDecimator(double columnWidth);
+
+    /// @brief Adds a sample; writes the points of a completed column (0, 1 or 2) to `out`.
+    /// @return The number of points written.
+    size_t add(double x, double y, PlotPoint out[2]);
+
+    /// @brief Emits the current, unfinished column and starts afresh.
+    size_t flush(PlotPoint out[2]);
+
+private:
+    size_t emit(PlotPoint out[2]) const;
+
+    double m_columnWidth;
+    bool m_open = false;
+    long long m_column = 0;
+    PlotPoint m_min{};
+    PlotPoint m_max{};
+};
+
+/// @brief min/max decimation of a whole series; see MinMaxDecimator.
+std::vector<PlotPoint> decimateMinMax(const std::vector<PlotPoint> &points, double columnWidth);
+
+/// @brief Largest-Triangle-Three-Buckets (Steinarsson, 2013): keeps the first and last
+///        point and, from each of `threshold - 2` buckets, the point forming the largest
+///        triangle with its neighbours. Keeps the visual shape of a series with a
+///        fixed number of points. Input must be sorted by x.
+std::vector<PlotPoint> decimateLttb(const std::vector<PlotPoint> &points, size_t threshold);
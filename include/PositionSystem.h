@@ -2,7 +2,52 @@
 
 #include "IPlant.h"
 
-class PositionSystem : public IPlant
+/// Double integrator: the control signal is an acceleration. Generic over the scalar type.
+template <typename Scalar = double>
+class BasicPositionSystem
+{
+public:
+    explicit BasicPositionSystem(Scalar time_step = Scalar(0.1))
+        : position_(0.0), velocity_(0.0), time_step_(time_step) {}
+
+    Scalar update(Scalar controlSignal)
+    {
+        velocity_ += controlSignal * time_step_;
+        position_ += velocity_ * time_step_;
+        return position_;
+    }
+
+    /// @brief Jumps `nSteps` updates ahead under a constant control signal in O(1).
+    ///
+    /// Closed form of the discrete recursion: v_N = v_0 + N u dt and
+    /// x_N = x_0 + N dt v_0 + u dt^2 N (N + 1) / 2. Matches `nSteps` calls of
+    /// update(controlSignal) up to rounding. `nSteps <= 0` changes nothing.
+    Scalar advance(Scalar controlSignal, long long nSteps)
+    {
+        if (nSteps <= 0)
+            return position_;
+
+        // N and the triangle number exceed a fixed-point Scalar's range long before the
+        // result does: the products are formed in double and converted once
+        const double n = static_cast<double>(nSteps);
+        const double triangle = 0.5 * n * static_cast<double>(nSteps + 1);
+        const double dt = static_cast<double>(time_step_);
+        const double increment = static_cast<double>(controlSignal * time_step_); // rounded as in update()
+
+        position_ += Scalar(n * dt * static_cast<double>(velocity_) + increment * dt * triangle);
+        velocity_ += Scalar(n * increment);
+        return position_;
+    }
+
+    Scalar getOutput() const { return position_; }
+
+private:
+    Scalar position_;
+    Scalar velocity_;
+    Scalar time_step_;
+};
+
+class PositionSystem final : public IPlant
 {
 public:
     explicit PositionSystem(double time_step = 0.1);
@@ -10,8 +55,9 @@ public:
     double update(double controlSignal) override;
     double getOutput() const override;
 
+    /// @brief Same result as `nSteps` calls of update(controlSignal), in O(1).
+    double advance(double controlSignal, long long nSteps);
+
 private:
-    double position_;
-    double velocity_;
-    double time_step_;
-};
\ No newline at end of file
+    BasicPositionSystem<double> system_;
+};
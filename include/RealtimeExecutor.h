@@ -0,0 +1,135 @@
+#pragma once
+
+#include "Pacing.h"
+#include "Simulation.h"
+#include <chrono>
+#include <cstddef>
+#include <ctime>
+#include <exception>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// @brief How the realtime control thread is set up.
+struct RealtimeConfig
+{
+    std::chrono::nanoseconds period = std::chrono::milliseconds(50);
+    int cpu = -1;                     ///< CPU to pin the thread to; -1 leaves the affinity alone.
+    int priority = 80;                ///< SCHED_FIFO priority, 1..99.
+    /// mlockall() current and future pages for the duration of the run. The lock is
+    /// process-wide: it is released after the run only if the process held no locked
+    /// memory before it, so a lock taken elsewhere is left in place.
+    bool lockMemory = true;
+    size_t stackPrefault = 256 << 10; ///< Bytes of stack touched up front so the loop never page-faults on it.
+};
+
+/// @brief What the executor managed to apply. Every step is best effort: a
+///        missing privilege leaves the flag false and adds a warning.
+struct RealtimeSetup
+{
+    bool pinned = false;
+    bool memoryLocked = false;
+    bool stackPrefaulted = false;
+    bool fifoScheduling = false;
+    std::vector<std::string> warnings;
+};
+
+/// @class DeadlineTimer
+/// @brief Absolute-deadline periodic timer on CLOCK_MONOTONIC.
+///
+/// Like Pacer, but sleeps with clock_nanosleep(TIMER_ABSTIME), which wakes at
+/// the deadline itself rather than after a relative interval, and counts a
+/// cycle whose work ends after its deadline as a miss.
+class DeadlineTimer
+{
+public:
+    explicit DeadlineTimer(std::chrono::nanoseconds period);
+
+    /// @brief Sets the schedule's epoch to now. Called by the constructor.
+    void restart();
+
+    /// @brief Sleeps until the end of the current cycle, or returns at once on a miss.
+    /// @return How late the loop resumes relative to the deadline, as Pacer::waitForNextStep().
+    std::chrono::nanoseconds waitForNextCycle();
+
+    const PacingStats &stats() const;
+
+private:
+    std::chrono::nanoseconds m_period;
+    timespec m_start;
+    PacingStats m_stats;
+};
+
+/// @class RealtimeExecutor
+/// @brief Runs a periodic loop on a dedicated thread configured for low jitter.
+///
+/// The thread is pinned to the configured CPU, memory is locked, the stack is
+/// pre-faulted and SCHED_FIFO is requested before the first cycle; whatever
+/// fails for lack of privileges is reported in setup() and the loop runs
+/// anyway. mlockall() is process-wide; see RealtimeConfig::lockMemory for when
+/// it is undone.
+class RealtimeExecutor
+{
+public:
+    explicit RealtimeExecutor(const RealtimeConfig &config = RealtimeConfig());
+
+    /// @brief Calls body(k) for k in [0, cycles), one per period, and waits for the last one.
+    /// @return Deadline miss accounting.
+    /// @note An exception thrown by body ends the run and is rethrown here once the thread has finished.
+    template <typename Body>
+    PacingStats run(long long cycles, Body &&body)
+    {
+        PacingStats stats;
+        std::exception_ptr error;
+        std::thread worker([&]()
+                           {
+            prepareThread();
+            DeadlineTimer timer(m_config.period);
+            try
+            {
+                for (long long k = 0; k < cycles; ++k)
+                {
+                    body(k);
+                    timer.waitForNextCycle();
+                }
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+            stats = timer.stats();
+            releaseMemory(); });
+        worker.join();
+        if (error)
+            std::rethrow_exception(error);
+        return stats;
+    }
+
+    /// @brief The outcome of the last run's thread setup.
+    const RealtimeSetup &setup() const;
+
+    const RealtimeConfig &config() const;
+
+private:
+    void prepareThread();
+    void releaseMemory();
+
+    RealtimeConfig m_config;
+    RealtimeSetup m_setup;
+    bool m_unlockAfterRun = false;
+};
+
+/// @brief simulate() on a RealtimeExecutor: one closed-loop step per configured period.
+/// @note Deadline lateness is not passed to `instrumentation`: the executor's
+///       timer sits outside the step body. Use the returned PacingStats instead.
+template <typename Plant, typename Controller, typename Observer, typename Instrumentation = NullInstrumentation>
+PacingStats simulateRealtime(RealtimeExecutor &executor, Plant &system, Controller &pid, double setpoint,
+                             int steps, Observer &&observer, Instrumentation &&instrumentation = Instrumentation())
+{
+    return executor.run(steps, [&](long long k)
+                        {
+        StepSample sample = closedLoopStep(system, pid, setpoint, k, instrumentation);
+        auto start = instrumentation.start();
+        observer(sample);
+        instrumentation.stop(LoopPhase::Observer, start); });
+}
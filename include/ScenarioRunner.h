@@ -0,0 +1,66 @@
+#pragma once
+
+#include "BasicPID.h"
+#include "IPlant.h"
+#include "Pacing.h"
+#include "StepSample.h"
+#include "ThreadPool.h"
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// @brief One closed-loop run: which plant, how the controller is set up, and for how long.
+struct Scenario
+{
+    std::string name;
+    std::string plant;       ///< "position", "velocity", "temperature" or "pendulum".
+    double timeStep = 0.0;   ///< Plant time step; 0 keeps the plant's default.
+    double setpoint = 1.0;
+    int steps = 100;
+    PIDGains<double> gains = {1.0, 0.1, 0.05, 1.0, -100.0, 100.0};
+};
+
+struct ScenarioResult
+{
+    std::string name;
+    std::vector<StepSample> samples; ///< One per step, in step order.
+    PacingStats pacing;
+};
+
+/// @brief Creates one of the plants by the name used in scenario files.
+/// @param timeStep Plant time step; 0 keeps the plant's default.
+/// @return nullptr for an unknown name.
+std::unique_ptr<IPlant> makeNamedPlant(const std::string &name, double timeStep = 0.0);
+
+/// @brief Reads scenarios, one per line:
+///
+///     name plant setpoint steps Kp Ki Kd [dt=.. antiwindup=.. min=.. max=..]
+///
+/// Blank lines and everything after '#' are ignored.
+/// @return false on the first malformed line; `error` then says which and why.
+bool parseScenarios(std::istream &in, std::vector<Scenario> &scenarios, std::string &error);
+
+bool loadScenarios(const std::string &path, std::vector<Scenario> &scenarios, std::string &error);
+
+/// @class ScenarioRunner
+/// @brief Runs independent scenarios concurrently on a thread pool.
+///
+/// Every scenario gets its own plant and its own controller, so no state leaks
+/// from one run into the next however they are scheduled. Results come back in
+/// the order of the input, so the output does not depend on the thread count.
+class ScenarioRunner
+{
+public:
+    explicit ScenarioRunner(ThreadPool &pool, const Pacing &pacing = Pacing::unthrottled());
+
+    /// @brief Runs a single scenario on the calling thread.
+    ScenarioResult run(const Scenario &scenario) const;
+
+    /// @brief Runs all scenarios in parallel. Results keep the input order.
+    std::vector<ScenarioResult> runAll(const std::vector<Scenario> &scenarios);
+
+private:
+    ThreadPool &pool;
+    Pacing pacing;
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "LoopInstrumentation.h"
+#include "Pacing.h"
+#include "StepSample.h"
+#include <iostream>
+
+/// @brief simulate()'s default observer: one human-readable line per step.
+///
+/// Lines end in '\n' rather than std::endl so the stream can buffer them; use
+/// a TelemetryLogger instead when the loop must not wait on I/O at all.
+struct ConsoleObserver
+{
+    std::ostream &out = std::cout;
+
+    void operator()(const StepSample &s) const
+    {
+        out << "Step " << s.step
+            << " | Setpoint: " << s.setpoint
+            << " | Output: " << s.output
+            << " | Error: " << s.error
+            << " | Control: " << s.control
+            << " | Response: " << s.response << '\n';
+    }
+};
+
+/// @brief Observer that forwards every sample to each of `observers`, in order.
+///
+/// The observers are held by reference and must outlive the returned object.
+template <typename... Observers>
+auto observeAll(Observers &...observers)
+{
+    return [&observers...](const StepSample &sample)
+    { (observers(sample), ...); };
+}
+
+/// @brief One control period: measure the plant, run the controller, drive the plant.
+///
+/// Plant needs `getOutput()` and `update(u)`, Controller needs `control(error)`.
+/// `instrumentation` times the controller and the plant update; see LoopInstrumentation.
+template <typename Plant, typename Controller, typename Instrumentation = NullInstrumentation>
+StepSample closedLoopStep(Plant &system, Controller &pid, double setpoint, long long step,
+                          Instrumentation &&instrumentation = Instrumentation())
+{
+    // Define simulation parameters
+    const double controlToVelocityGain = 1.0; // maps control signal to velocity change
+
+    double output = system.getOutput();
+    double error = setpoint - output;
+    auto start = instrumentation.start();
+    double controlSignal = pid.control(error);
+    auto controlled = instrumentation.stop(LoopPhase::Control, start);
+
+    // Simulate plant dynamics based on control signal
+    double response = system.update(controlSignal * controlToVelocityGain);
+    instrumentation.stop(LoopPhase::PlantUpdate, controlled);
+
+    return StepSample{step, setpoint, output, error, controlSignal, response};
+}
+
+/// @brief Runs a closed loop of `steps` control periods and reports every step.
+///
+/// Passing concrete types (e.g. a final plant and a BasicPID) lets the compiler
+/// inline the whole loop; IPlant& / IPID& still work and dispatch virtually.
+///
+/// `pacing` decides how the loop is spread over wall-clock time; the default
+/// reproduces the original one step per 50 ms, without accumulating drift.
+/// `observer` is called with a StepSample after every step. `instrumentation`
+/// (e.g. a LoopInstrumentation) times each phase and each deadline; the default
+/// NullInstrumentation adds no code at all.
+/// @return The pacer's overrun accounting.
+template <typename Plant, typename Controller, typename Observer = ConsoleObserver,
+          typename Instrumentation = NullInstrumentation>
+PacingStats simulate(Plant &system, Controller &pid, double setpoint, int steps,
+                     const Pacing &pacing = Pacing::realtime(0.05), Observer &&observer = Observer(),
+                     Instrumentation &&instrumentation = Instrumentation())
+{
+    Pacer pacer(pacing);
+    for (int i = 0; i < steps; ++i)
+    {
+        StepSample sample = closedLoopStep(system, pid, setpoint, i, instrumentation);
+
+        auto start = instrumentation.start();
+        observer(sample);
+        instrumentation.stop(LoopPhase::Observer, start);
+
+        instrumentation.deadline(pacer.waitForNextStep());
+    }
+    return pacer.stats();
+}
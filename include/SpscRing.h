@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/// @class SpscRing
+/// @brief Lock-free bounded FIFO for exactly one producer and one consumer thread.
+///
+/// Capacity is rounded up to a power of two so indices wrap with a mask. Each
+/// side keeps a cached copy of the other side's index and only reloads the
+/// shared atomic when the cache says the ring is full (or empty), so the common
+/// case touches no cache line owned by the other thread. Neither side blocks:
+/// tryPush() fails on a full ring and tryPop() on an empty one.
+template <typename T>
+class SpscRing
+{
+public:
+    explicit SpscRing(size_t capacity) : m_slots(roundUp(capacity)), m_mask(m_slots.size() - 1) {}
+
+    SpscRing(const SpscRing &) = delete;
+    SpscRing &operator=(const SpscRing &) = delete;
+
+    size_t capacity() const { return m_slots.size(); }
+
+    /// @brief Appends a value. Producer thread only.
+    /// @return false if the ring is full; the value is not stored.
+    bool tryPush(const T &value)
+    {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cachedHead == m_slots.size())
+        {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead == m_slots.size())
+                return false;
+        }
+
+        m_slots[tail & m_mask] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Removes the oldest value. Consumer thread only.
+    /// @return false if the ring is empty.
+    bool tryPop(T &value)
+    {
+        return popBatch(&value, 1) == 1;
+    }
+
+    /// @brief Removes up to `maxCount` of the oldest values in one go. Consumer thread only.
+    /// @return The number of values copied to `out`.
+    size_t popBatch(T *out, size_t maxCount)
+    {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (m_cachedTail - head < maxCount)
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+
+        size_t count = m_cachedTail - head;
+        if (count > maxCount)
+            count = maxCount;
+
+        for (size_t i = 0; i < count; ++i)
+            out[i] = m_slots[(head + i) & m_mask];
+        m_head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    /// @brief Approximate number of queued values; exact when called from either side while the other is idle.
+    size_t size() const
+    {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+
+private:
+    static size_t roundUp(size_t capacity)
+    {
+        size_t result = 1;
+        while (result < capacity)
+            result <<= 1;
+        return result;
+    }
+
+    std::vector<T> m_slots;
+    size_t m_mask;
+
+    // Producer and consumer state on separate cache lines so the two threads do not false-share.
+    alignas(64) std::atomic<size_t> m_tail{0};
+    size_t m_cachedHead = 0; // owned by the producer
+    alignas(64) std::atomic<size_t> m_head{0};
+    size_t m_cachedTail = 0; // owned by the consumer
+};
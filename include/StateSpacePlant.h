@@ -0,0 +1,200 @@
+#pragma once
+
+#include "IPlant.h"
+#include <array>
+#include <cstddef>
+
+namespace state_space
+{
+    /// Fixed-size dense matrix, stored row by row.
+    template <size_t Rows, size_t Cols>
+    using Matrix = std::array<std::array<double, Cols>, Rows>;
+
+    template <size_t N>
+    using Vector = std::array<double, N>;
+}
+
+namespace state_space_detail
+{
+    using state_space::Matrix;
+
+    template <size_t R, size_t K, size_t C>
+    Matrix<R, C> multiply(const Matrix<R, K> &a, const Matrix<K, C> &b)
+    {
+        Matrix<R, C> result{};
+        for (size_t r = 0; r < R; ++r)
+            for (size_t k = 0; k < K; ++k)
+                for (size_t c = 0; c < C; ++c)
+                    result[r][c] += a[r][k] * b[k][c];
+        return result;
+    }
+
+    template <size_t N>
+    Matrix<N, N> identity()
+    {
+        Matrix<N, N> result{};
+        for (size_t i = 0; i < N; ++i)
+            result[i][i] = 1.0;
+        return result;
+    }
+}
+
+/// @class StateSpacePlant
+/// @brief Discrete linear time-invariant plant with compile-time dimensions.
+///
+///     x[k+1] = A x[k] + B u[k]
+///     y[k+1] = C x[k+1] + D u[k]
+///
+/// All storage is inline (no heap allocation) and every loop has a
+/// compile-time trip count, so the compiler fully unrolls and vectorises update().
+template <size_t NX, size_t NU, size_t NY>
+class StateSpacePlant
+{
+public:
+    using State = state_space::Vector<NX>;
+    using Input = state_space::Vector<NU>;
+    using Output = state_space::Vector<NY>;
+
+    StateSpacePlant(const state_space::Matrix<NX, NX> &A, const state_space::Matrix<NX, NU> &B,
+                    const state_space::Matrix<NY, NX> &C, const state_space::Matrix<NY, NU> &D, const State &initialState = State{})
+        : A_(A), B_(B), C_(C), D_(D), x_(initialState), y_(outputOf(initialState, Input{}))
+    {
+    }
+
+    const Output &update(const Input &u)
+    {
+        State next{};
+        for (size_t i = 0; i < NX; ++i)
+        {
+            double sum = 0.0;
+            for (size_t j = 0; j < NX; ++j)
+                sum += A_[i][j] * x_[j];
+            for (size_t j = 0; j < NU; ++j)
+                sum += B_[i][j] * u[j];
+            next[i] = sum;
+        }
+        x_ = next;
+        y_ = outputOf(x_, u);
+        return y_;
+    }
+
+    /// @brief Jumps `nSteps` updates ahead under a constant input in O(log nSteps).
+    ///
+    /// Raises the augmented matrix [[A, B u], [0, 1]] to the nSteps-th power by
+    /// repeated squaring, so the forced response is included exactly.
+    const Output &advance(const Input &u, long long nSteps)
+    {
+        using state_space_detail::identity;
+        using state_space_detail::multiply;
+
+        if (nSteps <= 0)
+            return y_;
+
+        state_space::Matrix<NX + 1, NX + 1> step{};
+        for (size_t i = 0; i < NX; ++i)
+        {
+            for (size_t j = 0; j < NX; ++j)
+                step[i][j] = A_[i][j];
+            double forced = 0.0;
+            for (size_t j = 0; j < NU; ++j)
+                forced += B_[i][j] * u[j];
+            step[i][NX] = forced;
+        }
+        step[NX][NX] = 1.0;
+
+        state_space::Matrix<NX + 1, NX + 1> power = identity<NX + 1>();
+        for (long long n = nSteps; n > 0; n >>= 1)
+        {
+            if (n & 1)
+                power = multiply(power, step);
+            step = multiply(step, step);
+        }
+
+        State next{};
+        for (size_t i = 0; i < NX; ++i)
+        {
+            double sum = power[i][NX];
+            for (size_t j = 0; j < NX; ++j)
+                sum += power[i][j] * x_[j];
+            next[i] = sum;
+        }
+        x_ = next;
+        y_ = outputOf(x_, u);
+        return y_;
+    }
+
+    const State &state() const { return x_; }
+    const Output &output() const { return y_; }
+
+private:
+    Output outputOf(const State &x, const Input &u) const
+    {
+        Output y{};
+        for (size_t i = 0; i < NY; ++i)
+        {
+            double sum = 0.0;
+            for (size_t j = 0; j < NX; ++j)
+                sum += C_[i][j] * x[j];
+            for (size_t j = 0; j < NU; ++j)
+                sum += D_[i][j] * u[j];
+            y[i] = sum;
+        }
+        return y;
+    }
+
+    state_space::Matrix<NX, NX> A_;
+    state_space::Matrix<NX, NU> B_;
+    state_space::Matrix<NY, NX> C_;
+    state_space::Matrix<NY, NU> D_;
+    State x_;
+    Output y_;
+};
+
+/// @class SISOStateSpacePlant
+/// @brief IPlant adapter for single-input single-output state-space plants.
+template <size_t NX>
+class SISOStateSpacePlant final : public IPlant
+{
+public:
+    explicit SISOStateSpacePlant(const StateSpacePlant<NX, 1, 1> &plant) : plant_(plant) {}
+
+    double update(double controlSignal) override { return plant_.update({controlSignal})[0]; }
+    double getOutput() const override { return plant_.output()[0]; }
+    double advance(double controlSignal, long long nSteps) { return plant_.advance({controlSignal}, nSteps)[0]; }
+
+    const StateSpacePlant<NX, 1, 1> &plant() const { return plant_; }
+
+private:
+    StateSpacePlant<NX, 1, 1> plant_;
+};
+
+// The existing plants as state-space instances. Their discrete matrices
+// reproduce the semi-implicit Euler updates of the handwritten classes.
+
+/// PositionSystem: state (position, velocity); x' = x + dt v + dt^2 u, v' = v + dt u.
+inline StateSpacePlant<2, 1, 1> makePositionStateSpace(double time_step = 0.1)
+{
+    return {{{{1.0, time_step}, {0.0, 1.0}}}, {{{time_step * time_step}, {time_step}}}, {{{1.0, 0.0}}}, {{{0.0}}}};
+}
+
+/// VelocitySystem: state (velocity).
+inline StateSpacePlant<1, 1, 1> makeVelocityStateSpace(double time_step = 0.1)
+{
+    return {{{{1.0}}}, {{{time_step}}}, {{{1.0}}}, {{{0.0}}}};
+}
+
+/// TemperatureSystem: state (temperature), starting at the 20 degree ambient.
+inline StateSpacePlant<1, 1, 1> makeTemperatureStateSpace(double time_step = 0.1)
+{
+    return {{{{1.0}}}, {{{time_step}}}, {{{1.0}}}, {{{0.0}}}, {20.0}};
+}
+
+/// InvertedPendulumSystem linearised around angle 0 (sin(angle) ~ angle), with
+/// the default inertia, gravity and length. State (angle, angular velocity).
+/// Only valid for small angles; the nonlinear plant cannot be an LTI instance.
+inline StateSpacePlant<2, 1, 1> makeLinearisedPendulumStateSpace(double time_step = 0.01)
+{
+    const double g = 9.81, dt = time_step;
+    // angularVel' = angularVel + dt (u - g angle); angle' = angle + dt angularVel'
+    return {{{{1.0 - g * dt * dt, dt}, {-g * dt, 1.0}}}, {{{dt * dt}, {dt}}}, {{{1.0, 0.0}}}, {{{0.0}}}, {0.1, 0.0}};
+}
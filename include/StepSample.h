@@ -0,0 +1,12 @@
+#pragma once
+
+/// @brief Everything simulate() knows about one control period.
+struct StepSample
+{
+    long long step;
+    double setpoint;
+    double output;   ///< Plant output the controller saw.
+    double error;
+    double control;  ///< Controller output applied to the plant.
+    double response; ///< Plant output after the update.
+};
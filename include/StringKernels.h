@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/// @brief Instruction set used by the string kernels below.
+enum class StringKernel
+{
+    Scalar,
+    SSE42,
+    AVX2
+};
+
+/// @brief The best kernel the CPU supports; what the overloads without a kernel use.
+StringKernel bestStringKernel();
+
+/// @brief Returned by the find functions when there is no match.
+constexpr size_t stringNpos = static_cast<size_t>(-1);
+
+/// @brief Whether the `size` bytes at `a` and `b` are equal.
+bool stringEqual(const char *a, const char *b, size_t size);
+bool stringEqual(const char *a, const char *b, size_t size, StringKernel kernel);
+
+/// @brief Compares `size` bytes as unsigned chars, like memcmp.
+/// @return Negative, zero or positive as `a` sorts before, with or after `b`.
+int stringCompare(const char *a, const char *b, size_t size);
+int stringCompare(const char *a, const char *b, size_t size, StringKernel kernel);
+
+/// @brief Position of the first `c` in the `size` bytes at `str`, or stringNpos.
+size_t stringFind(const char *str, size_t size, char c);
+size_t stringFind(const char *str, size_t size, char c, StringKernel kernel);
+
+/// @brief Position of the first occurrence of `needle` in `str`, or stringNpos.
+///        An empty needle is found at 0.
+size_t stringFind(const char *str, size_t size, const char *needle, size_t needleSize);
+size_t stringFind(const char *str, size_t size, const char *needle, size_t needleSize, StringKernel kernel);
+
+/// @brief 64-bit hash of `size` bytes after wyhash (Wang Yi): 128-bit multiply-and-fold
+///        over 16-byte blocks, three independent lanes for long inputs. Fast and well
+///        mixed, but not meant to resist deliberate collisions.
+/// @note Same value on every kernel and every platform of the same endianness.
+uint64_t stringHash(const char *str, size_t size, uint64_t seed = 0);
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "SpscRing.h"
+#include "StepSample.h"
+#include <atomic>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// @class TelemetryLogger
+/// @brief Records StepSamples from a control loop to a binary file without blocking it.
+///
+/// record() only copies the sample into an SpscRing; a background thread drains
+/// the ring in batches and writes them out. When the writer falls behind and the
+/// ring is full, samples are dropped and counted instead of stalling the loop.
+/// Usable directly as a simulate() observer.
+///
+/// File format: a 16-byte header (the magic "PIDTLM1", a NUL, the record size
+/// as uint32 and four reserved bytes) followed by packed StepSample records in
+/// the host's byte order.
+class TelemetryLogger
+{
+public:
+    /// @param capacity Samples the ring holds before record() starts dropping.
+    /// @param batchSize Most samples the writer handles per write.
+    explicit TelemetryLogger(const std::string &path, size_t capacity = 1 << 16, size_t batchSize = 1024);
+
+    /// @brief Writes out everything still queued and closes the file.
+    ~TelemetryLogger();
+
+    TelemetryLogger(const TelemetryLogger &) = delete;
+    TelemetryLogger &operator=(const TelemetryLogger &) = delete;
+
+    /// @brief false if the file could not be created; every sample is then dropped.
+    bool isOpen() const;
+
+    /// @brief Queues a sample. Never blocks. Control thread only.
+    /// @return false if the sample was dropped.
+    bool record(const StepSample &sample);
+
+    void operator()(const StepSample &sample) { record(sample); }
+
+    /// @brief Stops the writer after it has drained the ring. Further samples are dropped.
+    /// @note Call from the control thread, or once it has stopped recording.
+    void close();
+
+    long long recorded() const; ///< Samples accepted by record().
+    long long dropped() const;  ///< Samples rejected by record().
+    long long written() const;  ///< Samples the writer has handed to the file so far.
+
+    /// @brief true once a write to the file has failed (disk full, I/O error).
+    ///        Samples of the failed and any later batches are not counted as written.
+    bool writeFailed() const;
+
+private:
+    void writerLoop();
+
+    SpscRing<StepSample> m_ring;
+    std::ofstream m_file; // owned by the writer thread once it runs
+    size_t m_batchSize;
+    bool m_open = false;
+
+    std::atomic<bool> m_stopping{false};
+    std::atomic<long long> m_recorded{0};
+    std::atomic<long long> m_dropped{0};
+    std::atomic<long long> m_written{0};
+    std::atomic<bool> m_writeFailed{false};
+    std::thread m_writer;
+};
+
+/// @brief Loads every record of a file written by TelemetryLogger.
+/// @return false if the file is missing or is not a telemetry file; a truncated
+///         trailing record is ignored.
+bool readTelemetry(const std::string &path, std::vector<StepSample> &samples);
+
+/// @brief One header line, then one comma-separated line per sample.
+void writeTelemetryCsv(const std::vector<StepSample> &samples, std::ostream &out);
+
+/// @brief Converts a binary telemetry file to CSV.
+bool exportTelemetryCsv(const std::string &binaryPath, const std::string &csvPath);
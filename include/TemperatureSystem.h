@@ -2,7 +2,42 @@
 
 #include "IPlant.h"
 
-class TemperatureSystem : public IPlant
+/// Integrator: the control signal is a heating rate. Generic over the scalar type.
+template <typename Scalar = double>
+class BasicTemperatureSystem
+{
+public:
+    explicit BasicTemperatureSystem(Scalar time_step = Scalar(0.1))
+        : temperature_(20.0), time_step_(time_step) {} // Assume ambient start temp
+
+    Scalar update(Scalar controlSignal)
+    {
+        temperature_ += controlSignal * time_step_;
+        return temperature_;
+    }
+
+    /// @brief Jumps `nSteps` updates ahead under a constant control signal in O(1).
+    /// Matches `nSteps` calls of update(controlSignal) up to rounding; `nSteps <= 0` changes nothing.
+    Scalar advance(Scalar controlSignal, long long nSteps)
+    {
+        if (nSteps <= 0)
+            return temperature_;
+
+        // The per-step increment is rounded as in update(); scaling it by N is done in
+        // double so a fixed-point Scalar does not saturate on N or the product
+        const Scalar increment = controlSignal * time_step_;
+        temperature_ += Scalar(static_cast<double>(nSteps) * static_cast<double>(increment));
+        return temperature_;
+    }
+
+    Scalar getOutput() const { return temperature_; }
+
+private:
+    Scalar temperature_;
+    Scalar time_step_;
+};
+
+class TemperatureSystem final : public IPlant
 {
 public:
     explicit TemperatureSystem(double time_step = 0.1);
@@ -10,7 +45,9 @@ public:
     double update(double controlSignal) override;
     double getOutput() const override;
 
+    /// @brief Same result as `nSteps` calls of update(controlSignal), in O(1).
+    double advance(double controlSignal, long long nSteps);
+
 private:
-    double temperature_;
-    double time_step_;
+    BasicTemperatureSystem<double> system_;
 };
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @class ThreadPool
+/// @brief Fixed-size work-stealing thread pool.
+///
+/// Every worker owns a deque: it pops its own work from the back and, when idle,
+/// steals from the front of the others. Tasks submitted from a worker go to that
+/// worker's deque, others are spread round-robin. Threads waiting in
+/// parallelFor() run pending tasks instead of sleeping, so nested calls are safe.
+class ThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+    /// @param threads Number of workers; 0 means std::thread::hardware_concurrency().
+    explicit ThreadPool(size_t threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    size_t size() const;
+
+    /// @brief Queues a task for asynchronous execution.
+    void submit(Task task);
+
+    /// @brief Calls body(i) for every i in [0, count) in parallel and waits for all of them.
+    /// @note The first exception thrown by body is rethrown here once every index has run.
+    template <typename Body>
+    void parallelFor(size_t count, Body &&body)
+    {
+        if (count == 0)
+            return;
+
+        struct Batch
+        {
+            std::atomic<size_t> remaining;
+            std::mutex errorMutex;
+            std::exception_ptr error;
+        };
+        auto batch = std::make_shared<Batch>();
+        batch->remaining.store(count, std::memory_order_relaxed);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            submit([batch, &body, i]()
+                   {
+                try
+                {
+                    body(i);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(batch->errorMutex);
+                    if (!batch->error)
+                        batch->error = std::current_exception();
+                }
+                batch->remaining.fetch_sub(1, std::memory_order_acq_rel); });
+        }
+
+        while (batch->remaining.load(std::memory_order_acquire) != 0)
+        {
+            if (!runPendingTask())
+                std::this_thread::yield();
+        }
+
+        if (batch->error)
+            std::rethrow_exception(batch->error);
+    }
+
+    /// @brief Runs one queued task on the calling thread, if there is one.
+    /// @return false if every deque was empty.
+    bool runPendingTask();
+
+private:
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(size_t index);
+    bool popOwn(size_t index, Task &task);
+    bool steal(size_t thief, Task &task);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+
+    std::atomic<size_t> nextWorker{0};
+    std::atomic<size_t> queued{0};
+    std::atomic<bool> stopping{false};
+
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+};
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "StepSample.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// @brief Read-only view of a contiguous array, e.g. one column of a mapped trace.
+template <typename T>
+class Column
+{
+public:
+    Column() = default;
+    Column(const T *data, size_t size) : m_data(data), m_size(size) {}
+
+    const T *data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    const T &operator[](size_t i) const { return m_data[i]; }
+    const T *begin() const { return m_data; }
+    const T *end() const { return m_data + m_size; }
+
+private:
+    const T *m_data = nullptr;
+    size_t m_size = 0;
+};
+
+/// @brief One run of a trace file. The columns point straight into the mapping
+///        and stay valid as long as the TraceReader they came from.
+struct TraceRun
+{
+    Column<int64_t> step;
+    Column<double> setpoint;
+    Column<double> output;
+    Column<double> error;
+    Column<double> control;
+    Column<double> response;
+
+    size_t size() const { return step.size(); }
+    StepSample sample(size_t k) const;
+};
+
+// Trace file layout, all in the host's byte order:
+//
+//   header  magic "PIDTRACE", version, runCount, indexOffset (64 bytes)
+//   runs    per run: 6 columns (step, setpoint, output, error, control,
+//           response) of `capacity` 8-byte values each, back to back
+//   index   per run: offset, capacity, steps (24 bytes)
+//
+// The index is written by TraceWriter::close(); until then the header's
+// indexOffset is 0 and readers reject the file.
+
+/// @class TraceWriter
+/// @brief Appends runs to a memory-mapped columnar trace file.
+///
+/// Samples are stored directly into the mapping, column by column, with no
+/// intermediate buffer. The file grows geometrically and is trimmed on close().
+/// Usable as a simulate() observer between beginRun() and endRun().
+class TraceWriter
+{
+public:
+    explicit TraceWriter(const std::string &path);
+
+    /// @brief Calls close().
+    ~TraceWriter();
+
+    TraceWriter(const TraceWriter &) = delete;
+    TraceWriter &operator=(const TraceWriter &) = delete;
+
+    bool isOpen() const;
+
+    /// @brief Reserves space for a run of up to `capacity` steps.
+    /// @return false if the file could not grow (or `capacity` is too large to
+    ///         address), or a run is already open.
+    bool beginRun(size_t capacity);
+
+    /// @brief Stores the next sample of the open run. Samples beyond its capacity are dropped.
+    void operator()(const StepSample &sample);
+
+    /// @brief Finishes the open run; its length is the number of samples stored.
+    void endRun();
+
+    /// @brief beginRun(), every sample, endRun().
+    bool appendRun(const std::vector<StepSample> &samples);
+
+    size_t runCount() const;
+
+    /// @brief Writes the index and header, trims and closes the file.
+    /// @return false if it was not open or the final write failed.
+    bool close();
+
+private:
+    struct IndexEntry
+    {
+        uint64_t offset;
+        uint64_t capacity;
+        uint64_t steps;
+    };
+
+    bool reserve(size_t bytes);
+    double *column(size_t c) const;
+
+    int m_fd = -1;
+    unsigned char *m_map = nullptr;
+    size_t m_mappedSize = 0;
+    size_t m_used = 0;
+
+    std::vector<IndexEntry> m_index;
+    bool m_runOpen = false;
+    IndexEntry m_run{};
+};
+
+/// @class TraceReader
+/// @brief Maps a trace file read-only and exposes its runs as columns, with no parsing or copying.
+class TraceReader
+{
+public:
+    explicit TraceReader(const std::string &path);
+    ~TraceReader();
+
+    TraceReader(const TraceReader &) = delete;
+    TraceReader &operator=(const TraceReader &) = delete;
+
+    /// @brief false if the file is missing, not a closed trace file, or inconsistent
+    ///        (including offsets that are not 8-byte aligned).
+    bool isOpen() const;
+
+    size_t runCount() const;
+    TraceRun run(size_t i) const;
+
+private:
+    const unsigned char *m_map = nullptr;
+    size_t m_size = 0;
+    size_t m_runCount = 0;
+    const uint64_t *m_index = nullptr;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/// @class TripleBuffer
+/// @brief Wait-free single-producer / single-consumer exchange of the latest value.
+///
+/// The writer fills a private back slot and swaps it with the shared middle slot;
+/// the reader swaps its front slot with the middle one when a new value is
+/// pending. Neither side ever blocks, retries or observes a half-written value.
+/// Intermediate values may be skipped: the reader always gets the most recent one.
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+    explicit TripleBuffer(const T &initial) : slots{initial, initial, initial} {}
+
+    /// @note Copying is not synchronised: neither buffer may be in use by another thread.
+    TripleBuffer(const TripleBuffer &other) { *this = other; }
+
+    TripleBuffer &operator=(const TripleBuffer &other)
+    {
+        for (int i = 0; i < 3; ++i)
+            slots[i] = other.slots[i];
+        middle.store(other.middle.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        front = other.front;
+        back = other.back;
+        return *this;
+    }
+
+    /// @brief Publishes a new value. Writer thread only.
+    void write(const T &value)
+    {
+        slots[back].value = value;
+        uint8_t previous = middle.exchange(static_cast<uint8_t>(back | dirtyBit), std::memory_order_acq_rel);
+        back = previous & indexMask;
+    }
+
+    /// @brief Makes the most recent published value visible through read(). Reader thread only.
+    /// @return true if a new value was picked up.
+    bool update()
+    {
+        if ((middle.load(std::memory_order_relaxed) & dirtyBit) == 0)
+            return false;
+
+        uint8_t previous = middle.exchange(front, std::memory_order_acq_rel);
+        front = previous & indexMask;
+        return true;
+    }
+
+    /// @brief The value picked up by the last successful update(). Reader thread only.
+    const T &read() const
+    {
+        return slots[front].value;
+    }
+
+private:
+    static constexpr uint8_t indexMask = 0x3;
+    static constexpr uint8_t dirtyBit = 0x4;
+
+    // Keep the slots on separate cache lines so the two threads do not false-share.
+    struct alignas(64) Slot
+    {
+        T value;
+    };
+
+    Slot slots[3]{};
+    std::atomic<uint8_t> middle{1};
+    uint8_t front = 0; // owned by the reader
+    uint8_t back = 2;  // owned by the writer
+};
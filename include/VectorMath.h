@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstddef>
+
+/// @brief Polynomial sine (Cephes coefficients), within ~1 ulp of std::sin for |x| <= 1e9.
+///        Larger, infinite and NaN arguments are passed to std::sin.
+///
+/// The scalar and the SIMD versions perform the same operations in the same
+/// order, so a value gets the same bits whichever path computes it.
+double polySin(double x);
+
+/// @brief out[i] = polySin(in[i]) for i in [0, count), four lanes at a time on AVX2.
+/// @note `in` and `out` may be the same array.
+void vectorSin(const double *in, double *out, size_t count);
@@ -2,7 +2,42 @@
 
 #include "IPlant.h"
 
-class VelocitySystem : public IPlant
+/// Integrator: the control signal is an acceleration, the output a velocity. Generic over the scalar type.
+template <typename Scalar = double>
+class BasicVelocitySystem
+{
+public:
+    explicit BasicVelocitySystem(Scalar time_step = Scalar(0.1))
+        : velocity_(0.0), time_step_(time_step) {}
+
+    Scalar update(Scalar controlSignal)
+    {
+        velocity_ += controlSignal * time_step_;
+        return velocity_;
+    }
+
+    /// @brief Jumps `nSteps` updates ahead under a constant control signal in O(1).
+    /// Matches `nSteps` calls of update(controlSignal) up to rounding; `nSteps <= 0` changes nothing.
+    Scalar advance(Scalar controlSignal, long long nSteps)
+    {
+        if (nSteps <= 0)
+            return velocity_;
+
+        // The per-step increment is rounded as in update(); scaling it by N is done in
+        // double so a fixed-point Scalar does not saturate on N or the product
+        const Scalar increment = controlSignal * time_step_;
+        velocity_ += Scalar(static_cast<double>(nSteps) * static_cast<double>(increment));
+        return velocity_;
+    }
+
+    Scalar getOutput() const { return velocity_; }
+
+private:
+    Scalar velocity_;
+    Scalar time_step_;
+};
+
+class VelocitySystem final : public IPlant
 {
 public:
     explicit VelocitySystem(double time_step = 0.1);
@@ -10,7 +45,9 @@ public:
     double update(double controlSignal) override;
     double getOutput() const override;
 
+    /// @brief Same result as `nSteps` calls of update(controlSignal), in O(1).
+    double advance(double controlSignal, long long nSteps);
+
 private:
-    double velocity_;
-    double time_step_;
+    BasicVelocitySystem<double> system_;
 };
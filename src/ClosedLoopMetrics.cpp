@@ -0,0 +1,120 @@
+#include "ClosedLoopMetrics.h"
+#include <algorithm>
+#include <cmath>
+
+ClosedLoopMetrics::ClosedLoopMetrics(double sampleTime, const StepResponseSpec &spec)
+    : m_sampleTime(sampleTime), m_spec(spec)
+{
+}
+
+void ClosedLoopMetrics::operator()(const StepSample &sample)
+{
+    const double t = static_cast<double>(m_samples) * m_sampleTime;
+    const double dt = m_sampleTime;
+    const double absError = std::fabs(sample.error);
+
+    if (m_samples == 0)
+    {
+        m_initialOutput = sample.output;
+        m_step = sample.setpoint - sample.output;
+    }
+    else
+    {
+        m_controlVariation += std::fabs(sample.control - m_lastControl);
+    }
+
+    if (m_step != 0.0)
+    {
+        // Fraction of the step covered so far; 1 means on the setpoint
+        double progress = (sample.output - m_initialOutput) / m_step;
+        if (!m_riseLowTime && progress >= m_spec.riseLow)
+            m_riseLowTime = t;
+        if (!m_riseHighTime && progress >= m_spec.riseHigh)
+            m_riseHighTime = t;
+        m_overshoot = std::max(m_overshoot, progress - 1.0);
+    }
+
+    bool inBand = absError <= m_spec.settlingBand * std::fabs(m_step);
+    if (inBand && !m_inBand)
+    {
+        m_enteredBandTime = t;
+        m_errorSumInBand = 0.0;
+        m_samplesInBand = 0;
+    }
+    m_inBand = inBand;
+    if (inBand)
+    {
+        m_errorSumInBand += sample.error;
+        ++m_samplesInBand;
+    }
+
+    m_iae += absError * dt;
+    m_ise += sample.error * sample.error * dt;
+    m_itae += t * absError * dt;
+    m_controlEnergy += sample.control * sample.control * dt;
+
+    m_lastError = sample.error;
+    m_lastControl = sample.control;
+    ++m_samples;
+}
+
+void ClosedLoopMetrics::reset()
+{
+    *this = ClosedLoopMetrics(m_sampleTime, m_spec);
+}
+
+long long ClosedLoopMetrics::samples() const
+{
+    return m_samples;
+}
+
+std::optional<double> ClosedLoopMetrics::riseTime() const
+{
+    if (!m_riseLowTime || !m_riseHighTime)
+        return std::nullopt;
+    return *m_riseHighTime - *m_riseLowTime;
+}
+
+std::optional<double> ClosedLoopMetrics::settlingTime() const
+{
+    if (!m_inBand)
+        return std::nullopt;
+    return m_enteredBandTime;
+}
+
+double ClosedLoopMetrics::overshoot() const
+{
+    return m_overshoot;
+}
+
+double ClosedLoopMetrics::steadyStateError() const
+{
+    if (!m_inBand || m_samplesInBand == 0)
+        return m_lastError;
+    return m_errorSumInBand / static_cast<double>(m_samplesInBand);
+}
+
+double ClosedLoopMetrics::iae() const
+{
+    return m_iae;
+}
+
+double ClosedLoopMetrics::ise() const
+{
+    return m_ise;
+}
+
+double ClosedLoopMetrics::itae() const
+{
+    return m_itae;
+}
+
+double ClosedLoopMetrics::controlEnergy() const
+{
+    return m_controlEnergy;
+}
+
+double ClosedLoopMetrics::controlVariation() const
+{
+    return m_controlVariation;
+}
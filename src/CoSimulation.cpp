@@ -0,0 +1,102 @@
+#include "CoSimulation.h"
+#include <algorithm>
+
+void EventScheduler::schedule(SimTime at, Task task, int priority)
+{
+    push(at, 0, std::make_shared<Task>(std::move(task)), priority);
+}
+
+void EventScheduler::every(SimTime first, SimTime period, Task task, int priority)
+{
+    push(first, std::max<SimTime>(period, 1), std::make_shared<Task>(std::move(task)), priority);
+}
+
+void EventScheduler::push(SimTime at, SimTime period, std::shared_ptr<Task> task, int priority)
+{
+    m_queue.push(Event{std::max(at, m_now), priority, m_sequence++, period, std::move(task)});
+}
+
+void EventScheduler::runUntil(SimTime end)
+{
+    while (!m_queue.empty() && m_queue.top().time < end)
+    {
+        Event event = m_queue.top();
+        m_queue.pop();
+        m_now = event.time;
+
+        // Re-arm periodic events first so the task sees them as pending
+        if (event.period > 0)
+            push(event.time + event.period, event.period, event.task, event.priority);
+
+        (*event.task)();
+        ++m_executed;
+    }
+    m_now = std::max(m_now, end);
+}
+
+SimTime EventScheduler::now() const
+{
+    return m_now;
+}
+
+size_t EventScheduler::pending() const
+{
+    return m_queue.size();
+}
+
+long long EventScheduler::executed() const
+{
+    return m_executed;
+}
+
+size_t CoSimulation::addLoop(IPlant &plant, IPID &controller, double setpoint, const LoopTiming &timing,
+                             Observer observer)
+{
+    m_loops.push_back(std::make_unique<Loop>(Loop{plant, controller, setpoint, timing, std::move(observer), 0.0, LoopStats{}}));
+    Loop *loop = m_loops.back().get();
+    const SimTime start = m_scheduler.now();
+
+    m_scheduler.every(start, timing.plantStep, [loop]()
+                      {
+        loop->plant.update(loop->heldControl);
+        ++loop->stats.plantSteps; }, PlantStep);
+
+    m_scheduler.every(start, timing.controlPeriod, [this, loop]()
+                      {
+        long long index = loop->stats.controlSamples++;
+        double measured = loop->plant.getOutput();
+
+        m_scheduler.schedule(m_scheduler.now() + loop->timing.sensorLatency, [this, loop, index, measured]()
+                             {
+            double error = loop->setpoint - measured;
+            double control = loop->controller.control(error);
+            if (loop->observer)
+                loop->observer(StepSample{index, loop->setpoint, measured, error, control, loop->plant.getOutput()});
+
+            m_scheduler.schedule(m_scheduler.now() + loop->timing.actuatorLatency, [loop, control]()
+                                 {
+                loop->heldControl = control;
+                ++loop->stats.actuations; }, Actuate); }, Compute); }, Sample);
+
+    return m_loops.size() - 1;
+}
+
+void CoSimulation::run(SimTime duration)
+{
+    m_scheduler.runUntil(m_scheduler.now() + duration);
+}
+
+SimTime CoSimulation::now() const
+{
+    return m_scheduler.now();
+}
+
+const LoopStats &CoSimulation::stats(size_t loop) const
+{
+    return m_loops[loop]->stats;
+}
+
+EventScheduler &CoSimulation::scheduler()
+{
+    return m_scheduler;
+}
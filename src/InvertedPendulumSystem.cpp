@@ -1,25 +1,27 @@
 #include "InvertedPendulumSystem.h"
 
 InvertedPendulumSystem::InvertedPendulumSystem(double time_step)
-    : angle_(0.1), angularVel_(0.0), time_step_(time_step) {}
+    : system_(time_step) {}
+
+InvertedPendulumSystem::InvertedPendulumSystem(double time_step, double inertia, double gravity, double length, double initialAngle)
+    : system_(time_step, inertia, gravity, length, initialAngle) {}
 
 double InvertedPendulumSystem::update(double controlSignal)
 {
-    // Simplified dynamics: torque = controlSignal
-    double inertia = 1.0;
-    double gravity = 9.81;
-    double length = 1.0;
-
-    double torque = controlSignal;
-    double angularAcc = (torque - gravity * std::sin(angle_) * length) / inertia;
+    return system_.update(controlSignal);
+}
 
-    angularVel_ += angularAcc * time_step_;
-    angle_ += angularVel_ * time_step_;
+double InvertedPendulumSystem::getOutput() const
+{
+    return system_.getOutput();
+}
 
-    return angle_;
+void InvertedPendulumSystem::setIntegrator(Integrator integrator, AdaptiveTolerance tolerance)
+{
+    system_.setIntegrator(integrator, tolerance);
 }
 
-double InvertedPendulumSystem::getOutput() const
+const IntegrationStats &InvertedPendulumSystem::integrationStats() const
 {
-    return angle_;
+    return system_.integrationStats();
 }
@@ -0,0 +1,189 @@
+#include "LatencyHistogram.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <ostream>
+
+LatencyHistogram::LatencyHistogram() : m_min(std::numeric_limits<uint64_t>::max())
+{
+    for (auto &bucket : m_buckets)
+        bucket.store(0, std::memory_order_relaxed);
+}
+
+size_t LatencyHistogram::bucketOf(uint64_t nanoseconds)
+{
+    if (nanoseconds < subBucketCount)
+        return static_cast<size_t>(nanoseconds);
+
+    int exponent = 63 - __builtin_clzll(nanoseconds);
+    if (exponent > maxExponent)
+        return bucketCount - 1;
+
+    // The top subBucketBits + 1 bits select the linear bucket inside this power of two
+    size_t top = static_cast<size_t>(nanoseconds >> (exponent - subBucketBits));
+    return subBucketCount + static_cast<size_t>(exponent - subBucketBits) * subBucketCount + (top - subBucketCount);
+}
+
+uint64_t LatencyHistogram::highestEquivalentValue(size_t bucket)
+{
+    if (bucket < subBucketCount)
+        return bucket;
+
+    size_t exponentOffset = (bucket - subBucketCount) / subBucketCount;
+    uint64_t top = subBucketCount + (bucket - subBucketCount) % subBucketCount;
+    uint64_t lowest = top << exponentOffset;
+    return lowest + (uint64_t(1) << exponentOffset) - 1;
+}
+
+void LatencyHistogram::record(uint64_t nanoseconds)
+{
+    m_buckets[bucketOf(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+    uint64_t current = m_min.load(std::memory_order_relaxed);
+    while (nanoseconds < current && !m_min.compare_exchange_weak(current, nanoseconds, std::memory_order_relaxed))
+    {
+    }
+    current = m_max.load(std::memory_order_relaxed);
+    while (nanoseconds > current && !m_max.compare_exchange_weak(current, nanoseconds, std::memory_order_relaxed))
+    {
+    }
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds duration)
+{
+    record(static_cast<uint64_t>(std::max<std::chrono::nanoseconds::rep>(duration.count(), 0)));
+}
+
+uint64_t LatencyHistogram::count() const
+{
+    return m_count.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::min() const
+{
+    return count() == 0 ? 0 : m_min.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::max() const
+{
+    return m_max.load(std::memory_order_relaxed);
+}
+
+double LatencyHistogram::mean() const
+{
+    uint64_t n = count();
+    return n == 0 ? 0.0 : static_cast<double>(m_sum.load(std::memory_order_relaxed)) / static_cast<double>(n);
+}
+
+uint64_t LatencyHistogram::percentile(double percentile) const
+{
+    uint64_t total = 0;
+    for (const auto &bucket : m_buckets)
+        total += bucket.load(std::memory_order_relaxed);
+    if (total == 0)
+        return 0;
+
+    double fraction = std::clamp(percentile, 0.0, 100.0) / 100.0;
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(total))));
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < bucketCount; ++i)
+    {
+        seen += m_buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank)
+            return std::min(highestEquivalentValue(i), max());
+    }
+    return max();
+}
+
+LatencySnapshot LatencyHistogram::snapshot() const
+{
+    LatencySnapshot s;
+    s.count = count();
+    s.min = min();
+    s.max = max();
+    s.mean = mean();
+    s.p50 = percentile(50.0);
+    s.p90 = percentile(90.0);
+    s.p99 = percentile(99.0);
+    s.p999 = percentile(99.9);
+    return s;
+}
+
+void LatencyHistogram::reset()
+{
+    for (auto &bucket : m_buckets)
+        bucket.store(0, std::memory_order_relaxed);
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_min.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+void writeSnapshot(std::ostream &out, const std::string &name, const LatencySnapshot &s)
+{
+    out << name
+        << " count=" << s.count
+        << " min=" << s.min
+        << " mean=" << s.mean
+        << " p50=" << s.p50
+        << " p90=" << s.p90
+        << " p99=" << s.p99
+        << " p99.9=" << s.p999
+        << " max=" << s.max << '\n';
+}
+
+LatencyReporter::LatencyReporter(std::ostream &out, std::chrono::milliseconds interval)
+    : m_out(out), m_interval(interval)
+{
+}
+
+LatencyReporter::~LatencyReporter()
+{
+    stop();
+}
+
+void LatencyReporter::add(const std::string &name, const LatencyHistogram &histogram)
+{
+    m_histograms.emplace_back(name, &histogram);
+}
+
+void LatencyReporter::start()
+{
+    if (m_thread.joinable())
+        return;
+
+    m_stopping = false;
+    m_thread = std::thread([this]()
+                           {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (!m_wake.wait_for(lock, m_interval, [this]() { return m_stopping; }))
+            report();
+        report(); });
+}
+
+void LatencyReporter::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    if (m_thread.joinable())
+        m_thread.join();
+}
+
+long long LatencyReporter::reports() const
+{
+    return m_reports.load(std::memory_order_relaxed);
+}
+
+void LatencyReporter::report()
+{
+    for (const auto &entry : m_histograms)
+        writeSnapshot(m_out, entry.first, entry.second->snapshot());
+    m_out.flush();
+    m_reports.fetch_add(1, std::memory_order_relaxed);
+}
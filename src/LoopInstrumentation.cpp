@@ -0,0 +1,26 @@
+#include "LoopInstrumentation.h"
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+double TscClockSource::nanosecondsPerTick()
+{
+    static const double rate = []()
+    {
+        // Count ticks across a short steady_clock interval
+        auto wallStart = std::chrono::steady_clock::now();
+        uint64_t tscStart = __rdtsc();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        uint64_t tscEnd = __rdtsc();
+        auto wallEnd = std::chrono::steady_clock::now();
+
+        double nanoseconds = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(wallEnd - wallStart).count());
+        return nanoseconds / static_cast<double>(tscEnd - tscStart);
+    }();
+    return rate;
+}
+
+void TscClockSource::calibrate()
+{
+    nanosecondsPerTick();
+}
+#endif
@@ -0,0 +1,96 @@
+#include "MemoryArena.h"
+#include <cstdint>
+
+MonotonicArena::MonotonicArena(size_t initialChunkSize, std::pmr::memory_resource *upstream)
+    : m_upstream(upstream), m_initialChunkSize(initialChunkSize > sizeof(Chunk) ? initialChunkSize : 4096),
+      m_nextChunkSize(m_initialChunkSize)
+{
+}
+
+MonotonicArena::MonotonicArena(void *buffer, size_t size, std::pmr::memory_resource *upstream)
+    : m_upstream(upstream), m_initialBuffer(buffer), m_initialSize(size),
+      m_initialChunkSize(2 * size > sizeof(Chunk) ? 2 * size : 4096), m_nextChunkSize(m_initialChunkSize)
+{
+    m_current = static_cast<char *>(buffer);
+    m_remaining = size;
+}
+
+MonotonicArena::~MonotonicArena()
+{
+    release();
+}
+
+void MonotonicArena::release()
+{
+    while (m_chunks)
+    {
+        Chunk *previous = m_chunks->previous;
+        m_upstream->deallocate(m_chunks, m_chunks->size, alignof(Chunk));
+        m_chunks = previous;
+    }
+    m_chunkCount = 0;
+    m_nextChunkSize = m_initialChunkSize;
+    m_used = 0;
+    m_current = static_cast<char *>(m_initialBuffer);
+    m_remaining = m_initialSize;
+}
+
+size_t MonotonicArena::bytesUsed() const
+{
+    return m_used;
+}
+
+size_t MonotonicArena::chunkCount() const
+{
+    return m_chunkCount;
+}
+
+void MonotonicArena::addChunk(size_t minimumBytes)
+{
+    size_t size = m_nextChunkSize;
+    while (size < minimumBytes + sizeof(Chunk))
+        size *= 2;
+    m_nextChunkSize = 2 * size;
+
+    Chunk *chunk = static_cast<Chunk *>(m_upstream->allocate(size, alignof(Chunk)));
+    chunk->previous = m_chunks;
+    chunk->size = size;
+    m_chunks = chunk;
+    ++m_chunkCount;
+
+    m_current = reinterpret_cast<char *>(chunk + 1);
+    m_remaining = size - sizeof(Chunk);
+}
+
+void *MonotonicArena::do_allocate(size_t bytes, size_t alignment)
+{
+    size_t padding = (alignment - reinterpret_cast<uintptr_t>(m_current) % alignment) % alignment;
+    if (!m_current || padding + bytes > m_remaining)
+    {
+        // Room for the worst-case padding as well
+        addChunk(bytes + alignment);
+        padding = (alignment - reinterpret_cast<uintptr_t>(m_current) % alignment) % alignment;
+    }
+
+    char *result = m_current + padding;
+    m_current += padding + bytes;
+    m_remaining -= padding + bytes;
+    m_used += padding + bytes;
+    return result;
+}
+
+void MonotonicArena::do_deallocate(void *, size_t, size_t)
+{
+    // Freed in bulk by release()
+}
+
+bool MonotonicArena::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+{
+    return this == &other;
+}
+
+std::pmr::memory_resource *threadLocalPool()
+{
+    thread_local std::pmr::unsynchronized_pool_resource pool;
+    return &pool;
+}
@@ -0,0 +1,254 @@
+#include "MonteCarloSweep.h"
+#include "InvertedPendulumSystem.h"
+#include "PID.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    // Rounded in double and clamped, so a tiny time step or a huge duration cannot overflow
+    long long stepCount(double duration, double dt)
+    {
+        if (!(dt > 0.0))
+            return 0;
+        double steps = std::round(duration / dt);
+        if (!(steps > 0.0))
+            return 0;
+        if (steps >= static_cast<double>(std::numeric_limits<long long>::max()))
+            return std::numeric_limits<long long>::max();
+        return static_cast<long long>(steps);
+    }
+}
+
+double Distribution::sample(CounterRng &rng) const
+{
+    switch (kind)
+    {
+    case Kind::Uniform:
+        return rng.uniform(a, b);
+    case Kind::Normal:
+        return rng.normal(a, b);
+    case Kind::Fixed:
+        break;
+    }
+    return a;
+}
+
+TrialParameters SweepSpace::sample(CounterRng &rng) const
+{
+    TrialParameters p;
+    p.timeStep = timeStep.sample(rng);
+    p.inertia = inertia.sample(rng);
+    p.length = length.sample(rng);
+    p.initialAngle = initialAngle.sample(rng);
+    p.Kp = Kp.sample(rng);
+    p.Ki = Ki.sample(rng);
+    p.Kd = Kd.sample(rng);
+    return p;
+}
+
+TrialPlantFactory pendulumTrials()
+{
+    return [](const TrialParameters &p)
+    {
+        return std::make_unique<InvertedPendulumSystem>(p.timeStep, p.inertia, 9.81, p.length, p.initialAngle);
+    };
+}
+
+Histogram::Histogram(double min, double max, size_t bins) : m_min(min), m_max(max), m_bins(bins > 0 ? bins : 1) {}
+
+void Histogram::add(double value)
+{
+    if (value < m_min)
+    {
+        ++m_underflow;
+        return;
+    }
+    // Classify before converting: the cast is undefined for NaN and huge values.
+    // NaN fails every comparison and lands in the overflow
+    if (!(value < m_max))
+    {
+        ++m_overflow;
+        return;
+    }
+    size_t bin = static_cast<size_t>((value - m_min) / (m_max - m_min) * static_cast<double>(m_bins.size()));
+    if (bin >= m_bins.size())
+        ++m_overflow;
+    else
+        ++m_bins[bin];
+}
+
+void Histogram::merge(const Histogram &other)
+{
+    for (size_t i = 0; i < m_bins.size() && i < other.m_bins.size(); ++i)
+        m_bins[i] += other.m_bins[i];
+    m_underflow += other.m_underflow;
+    m_overflow += other.m_overflow;
+}
+
+long long Histogram::count() const
+{
+    long long total = m_underflow + m_overflow;
+    for (long long n : m_bins)
+        total += n;
+    return total;
+}
+
+double Histogram::quantile(double q) const
+{
+    long long total = count();
+    if (total == 0)
+        return m_min;
+
+    double target = std::clamp(q, 0.0, 1.0) * static_cast<double>(total);
+    double seen = static_cast<double>(m_underflow);
+    if (target <= seen)
+        return m_min;
+
+    const double width = (m_max - m_min) / static_cast<double>(m_bins.size());
+    for (size_t i = 0; i < m_bins.size(); ++i)
+    {
+        double inBin = static_cast<double>(m_bins[i]);
+        if (inBin > 0.0 && target <= seen + inBin)
+            return m_min + width * (static_cast<double>(i) + (target - seen) / inBin);
+        seen += inBin;
+    }
+    return m_max;
+}
+
+MetricSummary::MetricSummary(const Histogram &histogram)
+    : m_min(std::numeric_limits<double>::infinity()),
+      m_max(-std::numeric_limits<double>::infinity()),
+      m_histogram(histogram)
+{
+}
+
+void MetricSummary::add(double value)
+{
+    ++m_count;
+    double delta = value - m_mean;
+    m_mean += delta / static_cast<double>(m_count);
+    m_m2 += delta * (value - m_mean);
+    m_min = std::min(m_min, value);
+    m_max = std::max(m_max, value);
+    m_histogram.add(value);
+}
+
+void MetricSummary::merge(const MetricSummary &other)
+{
+    if (other.m_count == 0)
+        return;
+
+    long long count = m_count + other.m_count;
+    double delta = other.m_mean - m_mean;
+    m_mean += delta * static_cast<double>(other.m_count) / static_cast<double>(count);
+    m_m2 += other.m_m2 + delta * delta * static_cast<double>(m_count) * static_cast<double>(other.m_count) / static_cast<double>(count);
+    m_count = count;
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+    m_histogram.merge(other.m_histogram);
+}
+
+double MetricSummary::stddev() const
+{
+    return m_count > 1 ? std::sqrt(m_m2 / static_cast<double>(m_count - 1)) : 0.0;
+}
+
+MonteCarloSweep::MonteCarloSweep(SweepProblem problem, ThreadPool &pool)
+    : problem(std::move(problem)), pool(pool)
+{
+}
+
+TrialParameters MonteCarloSweep::parameters(uint64_t seed, long long index) const
+{
+    CounterRng rng(seed, static_cast<uint64_t>(index));
+    return problem.space.sample(rng);
+}
+
+TrialOutcome MonteCarloSweep::runTrial(const TrialParameters &parameters) const
+{
+    std::unique_ptr<IPlant> plantPtr = problem.makePlant(parameters);
+    PID controller(parameters.Kp, parameters.Ki, parameters.Kd);
+    controller.setOutputLimits(problem.outputMin, problem.outputMax);
+
+    IPlant &plant = *plantPtr;
+    IPID &pid = controller;
+
+    const double dt = parameters.timeStep;
+    const long long steps = stepCount(problem.duration, dt);
+    const double stepSize = problem.setpoint - plant.getOutput();
+    const double divergenceLimit = 1e6 * std::max(1.0, std::fabs(stepSize));
+
+    TrialOutcome outcome{0.0, 0.0, std::fabs(stepSize), true};
+    for (long long step = 0; step < steps; ++step)
+    {
+        double output = plant.getOutput();
+        double error = problem.setpoint - output;
+        if (!std::isfinite(output) || std::fabs(error) > divergenceLimit)
+        {
+            outcome.stable = false;
+            break;
+        }
+
+        outcome.iae += std::fabs(error) * dt;
+        if (stepSize != 0.0)
+            outcome.overshoot = std::max(outcome.overshoot, (output - problem.setpoint) / stepSize);
+
+        plant.update(pid.control(error));
+    }
+
+    double finalError = problem.setpoint - plant.getOutput();
+    if (!std::isfinite(finalError) || std::fabs(finalError) > divergenceLimit)
+        outcome.stable = false;
+    outcome.finalError = std::fabs(finalError);
+    return outcome;
+}
+
+SweepResult MonteCarloSweep::run(const SweepOptions &options) const
+{
+    const long long chunkSize = std::max(1LL, options.chunkSize);
+    const long long trials = std::max(0LL, options.trials);
+    const size_t chunks = static_cast<size_t>((trials + chunkSize - 1) / chunkSize);
+
+    auto emptyResult = [&]()
+    {
+        SweepResult result;
+        result.iae = MetricSummary(options.iaeHistogram);
+        result.overshoot = MetricSummary(options.overshootHistogram);
+        result.finalError = MetricSummary(options.finalErrorHistogram);
+        return result;
+    };
+
+    // Chunk boundaries depend only on the options, never on the thread count
+    std::vector<SweepResult> partial(chunks, emptyResult());
+    pool.parallelFor(chunks, [&](size_t chunk)
+                     {
+        SweepResult &result = partial[chunk];
+        long long first = static_cast<long long>(chunk) * chunkSize;
+        long long last = std::min(trials, first + chunkSize);
+        for (long long i = first; i < last; ++i)
+        {
+            TrialOutcome outcome = runTrial(parameters(options.seed, i));
+            ++result.trials;
+            if (!outcome.stable)
+            {
+                ++result.unstable;
+                continue;
+            }
+            result.iae.add(outcome.iae);
+            result.overshoot.add(outcome.overshoot);
+            result.finalError.add(outcome.finalError);
+        } });
+
+    SweepResult total = emptyResult();
+    for (const SweepResult &result : partial)
+    {
+        total.trials += result.trials;
+        total.unstable += result.unstable;
+        total.iae.merge(result.iae);
+        total.overshoot.merge(result.overshoot);
+        total.finalError.merge(result.finalError);
+    }
+    return total;
+}
@@ -1,23 +1,88 @@
 #include "MyString.h"
-#include <iostream>
 #include <cstring>
+#include <functional>
 
-MyString::MyString() : m_size(0)
+void MyString::allocate(size_t size)
 {
-    std::cout << "[Default Constructor]" << std::endl;
-    m_data = new char[1];
-    m_data[0] = '\0';
+    m_size = size;
+    if (size <= inlineCapacity)
+    {
+        m_data = m_inline;
+        m_capacity = 0;
+        return;
+    }
+    m_data = static_cast<char *>(m_resource->allocate(size + 1, alignof(char)));
+    m_capacity = size;
+    MyStringTrace::allocation(size + 1);
 }
 
-MyString::~MyString()
+void MyString::release()
 {
-    std::cout << "[Destructor]" << std::endl;
-    if (m_data)
+    if (m_data != m_inline)
     {
-        delete[] m_data;
+        m_resource->deallocate(m_data, m_capacity + 1, alignof(char));
+        MyStringTrace::deallocation();
     }
 }
 
+void MyString::becomeEmpty()
+{
+    m_data = m_inline;
+    m_size = 0;
+    m_capacity = 0;
+    m_inline[0] = '\0';
+    m_hash.store(0, std::memory_order_relaxed);
+}
+
+void MyString::takeStorage(MyString &str)
+{
+    if (str.isInline())
+    {
+        // Nothing to steal: copy the few inline bytes
+        m_data = m_inline;
+        m_size = str.m_size;
+        m_capacity = 0;
+        std::memcpy(m_inline, str.m_inline, m_size + 1);
+    }
+    else
+    {
+        m_data = str.m_data;
+        m_size = str.m_size;
+        m_capacity = str.m_capacity;
+    }
+    m_hash.store(str.m_hash.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    str.becomeEmpty();
+}
+
+MyString::MyString() : m_resource(std::pmr::get_default_resource()), m_hash(0)
+{
+    MyStringTrace::event(MyStringEvent::Construction, "[Default Constructor]");
+    becomeEmpty();
+}
+
+MyString::MyString(const allocator_type &allocator) : m_resource(allocator.resource()), m_hash(0)
+{
+    MyStringTrace::event(MyStringEvent::Construction, "[Default Constructor]");
+    becomeEmpty();
+}
+
+MyString::~MyString()
+{
+    MyStringTrace::event(MyStringEvent::Destruction, "[Destructor]");
+    release();
+}
+
+MyStringStats MyString::stats()
+{
+    return MyStringTrace::stats();
+}
+
+void MyString::resetStats()
+{
+    MyStringTrace::reset();
+}
+
 const char *MyString::c_str() const
 {
     return this->m_data;
@@ -28,58 +93,100 @@ size_t MyString::size() const
     return this->m_size;
 }
 
-MyString::MyString(const char *str)
+bool MyString::isInline() const
+{
+    return m_data == m_inline;
+}
+
+MyString::allocator_type MyString::get_allocator() const
+{
+    return allocator_type(m_resource);
+}
+
+MyString::MyString(const char *str, const allocator_type &allocator) : m_resource(allocator.resource()), m_hash(0)
 {
-    std::cout << "[Constructor from const char*]" << std::endl;
-    m_size = strlen(str);
-    m_data = new char[m_size + 1];
+    MyStringTrace::event(MyStringEvent::Construction, "[Constructor from const char*]");
+    allocate(strlen(str));
     memcpy(m_data, str, m_size + 1);
 }
 
-MyString::MyString(const MyString &str)
+MyString::MyString(const MyString &str) : MyString(str, allocator_type()) {}
+
+MyString::MyString(const MyString &str, const allocator_type &allocator)
+    : m_resource(allocator.resource()), m_hash(str.m_hash.load(std::memory_order_relaxed))
 {
-    std::cout << "[Copy Constructor]" << std::endl;
-    m_size = str.m_size;
-    m_data = new char[m_size + 1];
+    MyStringTrace::event(MyStringEvent::Copy, "[Copy Constructor]");
+    allocate(str.m_size);
     memcpy(m_data, str.m_data, m_size + 1);
 }
 
-MyString::MyString(MyString &&str) noexcept
+MyString::MyString(MyString &&str) noexcept : m_resource(str.m_resource), m_hash(0)
 {
-    std::cout << "[Move Constructor]" << std::endl;
-    m_size = str.m_size;
-    m_data = str.m_data;
+    MyStringTrace::event(MyStringEvent::Move, "[Move Constructor]");
+    takeStorage(str);
+}
+
+MyString::MyString(MyString &&str, const allocator_type &allocator) : m_resource(allocator.resource()), m_hash(0)
+{
+    MyStringTrace::event(MyStringEvent::Move, "[Move Constructor]");
+    if (str.isInline() || m_resource->is_equal(*str.m_resource))
+    {
+        takeStorage(str);
+        return;
+    }
 
-    str.m_data = nullptr;
-    str.m_size = 0;
+    // Memory from another resource cannot be adopted
+    allocate(str.m_size);
+    std::memcpy(m_data, str.m_data, m_size + 1);
+    m_hash.store(str.m_hash.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    str.release();
+    str.becomeEmpty();
 }
 
 MyString &MyString::operator=(const MyString &str)
 {
-    std::cout << "[Copy Assignment Operator]" << std::endl;
+    MyStringTrace::event(MyStringEvent::Copy, "[Copy Assignment Operator]");
 
     // Self-assignment guard
     if (this == &str)
         return *this;
 
-    delete[] m_data;
-
-    m_size = str.m_size;
-    m_data = new char[m_size + 1];
-    std::memcpy(m_data, str.m_data, m_size + 1);
+    if (str.isInline())
+    {
+        release();
+        allocate(str.m_size); // inline: cannot throw
+        std::memcpy(m_data, str.m_data, m_size + 1);
+        m_hash.store(str.m_hash.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    else
+    {
+        assignToNewBlock(str);
+    }
 
     return *this;
 }
 
-MyString &MyString::operator=(MyString &&str) noexcept
+MyString &MyString::operator=(MyString &&str)
 {
-    std::cout << "[Move Assignment Operator]" << std::endl;
+    MyStringTrace::event(MyStringEvent::Move, "[Move Assignment Operator]");
 
-    m_size = str.m_size;
-    m_data = str.m_data;
+    // Self-assignment guard
+    if (this == &str)
+        return *this;
 
-    str.m_data = nullptr;
-    str.m_size = 0;
+    if (str.isInline() || m_resource->is_equal(*str.m_resource))
+    {
+        release();
+        takeStorage(str);
+    }
+    else
+    {
+        // Memory from another resource cannot be adopted: copy it. If the
+        // allocation throws, both strings are left as they were
+        assignToNewBlock(str);
+        str.release();
+        str.becomeEmpty();
+    }
 
     return *this;
 }
@@ -89,19 +196,139 @@ bool MyString::operator==(const MyString &other) const
     if (m_size != other.m_size)
         return false;
 
-    return std::strncmp(m_data, other.m_data, m_size) == 0;
+    // Different cached hashes settle it without touching the characters
+    size_t hash = m_hash.load(std::memory_order_relaxed);
+    size_t otherHash = other.m_hash.load(std::memory_order_relaxed);
+    if (hash != 0 && otherHash != 0 && hash != otherHash)
+        return false;
+
+    return stringEqual(m_data, other.m_data, m_size);
+}
+
+bool MyString::operator!=(const MyString &other) const
+{
+    return !(*this == other);
+}
+
+int MyString::compare(const MyString &other) const
+{
+    size_t common = m_size < other.m_size ? m_size : other.m_size;
+    int result = stringCompare(m_data, other.m_data, common);
+    if (result != 0)
+        return result;
+    return m_size < other.m_size ? -1 : (m_size > other.m_size ? 1 : 0);
+}
+
+bool MyString::operator<(const MyString &other) const
+{
+    return compare(other) < 0;
+}
+
+size_t MyString::find(char c, size_t pos) const
+{
+    if (pos >= m_size)
+        return npos;
+    size_t found = stringFind(m_data + pos, m_size - pos, c);
+    return found == npos ? npos : pos + found;
+}
+
+size_t MyString::find(const char *str, size_t pos) const
+{
+    return find(str, strlen(str), pos);
+}
+
+size_t MyString::find(const MyString &str, size_t pos) const
+{
+    return find(str.m_data, str.m_size, pos);
+}
+
+size_t MyString::find(const char *str, size_t count, size_t pos) const
+{
+    if (pos > m_size)
+        return npos;
+    size_t found = stringFind(m_data + pos, m_size - pos, str, count);
+    return found == npos ? npos : pos + found;
+}
+
+size_t MyString::hash() const
+{
+    // 0 marks "not computed": a string that really hashes to 0 is simply rehashed each time
+    size_t hash = m_hash.load(std::memory_order_relaxed);
+    if (hash == 0)
+    {
+        hash = static_cast<size_t>(stringHash(m_data, m_size));
+        m_hash.store(hash, std::memory_order_relaxed);
+    }
+    return hash;
+}
+
+size_t MyString::capacity() const
+{
+    return isInline() ? inlineCapacity : m_capacity;
+}
+
+void MyString::reserve(size_t capacity)
+{
+    if (capacity > this->capacity())
+        grow(capacity);
+}
+
+void MyString::assignToNewBlock(const MyString &str)
+{
+    char *data = static_cast<char *>(m_resource->allocate(str.m_size + 1, alignof(char)));
+    MyStringTrace::allocation(str.m_size + 1);
+    std::memcpy(data, str.m_data, str.m_size + 1);
+
+    release();
+    m_data = data;
+    m_size = str.m_size;
+    m_capacity = str.m_size;
+    m_hash.store(str.m_hash.load(std::memory_order_relaxed), std::memory_order_relaxed);
 }
 
-MyString MyString::operator+(const MyString &other) const
+void MyString::grow(size_t capacity)
 {
-    size_t newSize = m_size + other.m_size;
-    char *newData = new char[newSize + 1];
+    // Geometric growth keeps a sequence of appends amortized O(1)
+    size_t newCapacity = 2 * this->capacity();
+    if (newCapacity < capacity)
+        newCapacity = capacity;
 
-    std::memcpy(newData, m_data, m_size);
-    std::memcpy(newData + m_size, other.m_data, other.m_size);
-    newData[newSize] = '\0';
+    char *newData = static_cast<char *>(m_resource->allocate(newCapacity + 1, alignof(char)));
+    MyStringTrace::allocation(newCapacity + 1);
+    std::memcpy(newData, m_data, m_size + 1);
 
-    MyString result(newData);
-    delete[] newData;
-    return result;
-}
\ No newline at end of file
+    release();
+    m_data = newData;
+    m_capacity = newCapacity;
+}
+
+MyString &MyString::append(const char *str, size_t count)
+{
+    size_t newSize = m_size + count;
+    if (newSize > capacity())
+    {
+        // `str` may point into the buffer about to be released
+        std::less_equal<const char *> before;
+        bool aliased = before(m_data, str) && before(str, m_data + m_size);
+        size_t offset = aliased ? static_cast<size_t>(str - m_data) : 0;
+        grow(newSize);
+        if (aliased)
+            str = m_data + offset;
+    }
+
+    std::memmove(m_data + m_size, str, count);
+    m_size = newSize;
+    m_data[m_size] = '\0';
+    m_hash.store(0, std::memory_order_relaxed);
+    return *this;
+}
+
+MyString &MyString::append(const char *str)
+{
+    return append(str, strlen(str));
+}
+
+MyString &MyString::append(const MyString &str)
+{
+    return append(str.m_data, str.m_size);
+}
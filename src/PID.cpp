@@ -1,71 +1,58 @@
 #include "PID.h"
-#include <algorithm>
-#include <iostream>
 
-PID::PID() : Kp(0), Ki(0), Kd(0), cumulativeError(0), previousError(0), antiWindupGain(1.0)
+PID::PID() : impl()
 {
 }
 
-PID::PID(double Kp, double Ki, double Kd) : Kp(Kp), Ki(Ki), Kd(Kd), cumulativeError(0), previousError(0), antiWindupGain(1.0)
+PID::PID(double Kp, double Ki, double Kd) : impl(Kp, Ki, Kd)
 {
 }
 
 double PID::control(double error)
 {
-    double P = error * this->Kp;
-
-    // Store pre-clamped cumulativeError for backup
-    double proposedCumulativeError = this->cumulativeError + error;
-    double I = proposedCumulativeError * this->Ki;
-
-    double D = (error - this->previousError) * this->Kd;
-    this->previousError = error;
-
-    double output = P + I + D;
-    double clampedOutput = std::clamp(output, outputMin, outputMax);
-
-    if (output != clampedOutput)
+    if (pendingGains.update())
     {
-        // Only partially integrate when clamped
-        this->cumulativeError += error * (1.0 - antiWindupGain);
+        impl.applyGains(pendingGains.read());
     }
-    else
-    {
-        // Normal integration
-        this->cumulativeError = proposedCumulativeError;
-    }
-
-    return clampedOutput;
+    return impl.control(error);
 }
 
 void PID::setKp(double kp)
 {
-    this->Kp = kp;
+    impl.setKp(kp);
 }
 
 void PID::setKi(double ki)
 {
-    this->Ki = ki;
+    impl.setKi(ki);
 }
 
 void PID::setKd(double kd)
 {
-    this->Kd = kd;
+    impl.setKd(kd);
 }
 
 void PID::setAntiWindupGain(double gain)
 {
-    this->antiWindupGain = gain;
+    impl.setAntiWindupGain(gain);
 }
 
 void PID::setOutputLimits(double min, double max)
 {
-    this->outputMin = min;
-    this->outputMax = max;
+    impl.setOutputLimits(min, max);
 }
 
 void PID::reset()
 {
-    this->cumulativeError = 0;
-    this->previousError = 0;
+    impl.reset();
+}
+
+void PID::publishGains(const PIDGains<double> &gains)
+{
+    pendingGains.write(gains);
+}
+
+PIDGains<double> PID::gains() const
+{
+    return impl.gainSet();
 }
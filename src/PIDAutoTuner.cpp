@@ -0,0 +1,270 @@
+#include "PIDAutoTuner.h"
+#include "BasicPID.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace
+{
+    // Costs of diverging runs start here; runs that diverge later rank better.
+    constexpr double unstableCost = 1e12;
+
+    constexpr double pi = 3.14159265358979323846;
+
+    GainCandidate project(double Kp, double Ki, double Kd)
+    {
+        // Negative gains turn negative feedback into positive feedback
+        return {std::max(0.0, Kp), std::max(0.0, Ki), std::max(0.0, Kd)};
+    }
+
+    // a + t * (b - a), component-wise
+    GainCandidate lerp(const GainCandidate &a, const GainCandidate &b, double t)
+    {
+        return project(a.Kp + t * (b.Kp - a.Kp), a.Ki + t * (b.Ki - a.Ki), a.Kd + t * (b.Kd - a.Kd));
+    }
+
+    double sample(const GainRange &range, size_t i)
+    {
+        if (range.count <= 1)
+            return range.min;
+        return range.min + (range.max - range.min) * static_cast<double>(i) / static_cast<double>(range.count - 1);
+    }
+}
+
+PIDAutoTuner::PIDAutoTuner(TuningProblem problem, ThreadPool &pool, CostWeights weights)
+    : problem(std::move(problem)), weights(weights), pool(pool)
+{
+}
+
+LoopScore PIDAutoTuner::evaluate(const GainCandidate &gains) const
+{
+    std::unique_ptr<IPlant> plant = problem.makePlant();
+    BasicPID<double> pid(gains.Kp, gains.Ki, gains.Kd);
+    pid.setOutputLimits(problem.outputMin, problem.outputMax);
+
+    const double dt = problem.sampleTime;
+    const double stepSize = problem.setpoint - plant->getOutput();
+    const double divergenceLimit = 1e6 * std::max(1.0, std::fabs(stepSize));
+
+    LoopScore score{0.0, 0.0, 0.0, 0.0, true};
+    int step = 0;
+    for (; step < problem.steps; ++step)
+    {
+        double output = plant->getOutput();
+        double error = problem.setpoint - output;
+        if (!std::isfinite(output) || std::fabs(error) > divergenceLimit)
+        {
+            score.stable = false;
+            break;
+        }
+
+        score.iae += std::fabs(error) * dt;
+        score.itae += step * dt * std::fabs(error) * dt;
+        if (stepSize != 0.0)
+            score.overshoot = std::max(score.overshoot, (output - problem.setpoint) / stepSize);
+
+        plant->update(pid.control(error));
+    }
+
+    if (score.stable)
+        score.cost = weights.iae * score.iae + weights.itae * score.itae + weights.overshoot * score.overshoot;
+    else
+        score.cost = unstableCost * (2.0 - static_cast<double>(step) / problem.steps);
+
+    return score;
+}
+
+std::vector<LoopScore> PIDAutoTuner::evaluateAll(const std::vector<GainCandidate> &candidates)
+{
+    std::vector<LoopScore> scores(candidates.size());
+    pool.parallelFor(candidates.size(), [&](size_t i)
+                     { scores[i] = evaluate(candidates[i]); });
+    evaluationCount += candidates.size();
+    return scores;
+}
+
+TuningResult PIDAutoTuner::gridSearch(const GainRange &kp, const GainRange &ki, const GainRange &kd)
+{
+    std::vector<GainCandidate> candidates;
+    candidates.reserve(kp.count * ki.count * kd.count);
+    for (size_t p = 0; p < kp.count; ++p)
+        for (size_t i = 0; i < ki.count; ++i)
+            for (size_t d = 0; d < kd.count; ++d)
+                candidates.push_back({sample(kp, p), sample(ki, i), sample(kd, d)});
+
+    size_t before = evaluationCount;
+    std::vector<LoopScore> scores = evaluateAll(candidates);
+
+    // First minimum wins, so the result does not depend on scheduling
+    size_t best = 0;
+    for (size_t c = 1; c < scores.size(); ++c)
+        if (scores[c].cost < scores[best].cost)
+            best = c;
+
+    return {candidates[best], scores[best], evaluationCount - before};
+}
+
+TuningResult PIDAutoTuner::nelderMead(const GainCandidate &start, const NelderMeadOptions &options)
+{
+    // Standard coefficients: reflection, expansion, contraction, shrink
+    const double alpha = 1.0, gamma = 2.0, rho = 0.5, sigma = 0.5;
+    size_t before = evaluationCount;
+
+    auto offset = [&](double value)
+    { return options.initialStep * (value != 0.0 ? std::fabs(value) : 1.0); };
+
+    std::vector<GainCandidate> simplex = {
+        start,
+        project(start.Kp + offset(start.Kp), start.Ki, start.Kd),
+        project(start.Kp, start.Ki + offset(start.Ki), start.Kd),
+        project(start.Kp, start.Ki, start.Kd + offset(start.Kd))};
+    std::vector<LoopScore> scores = evaluateAll(simplex);
+
+    std::array<size_t, 4> order = {0, 1, 2, 3};
+    for (int iteration = 0; iteration < options.maxIterations; ++iteration)
+    {
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b)
+                         { return scores[a].cost < scores[b].cost; });
+        size_t best = order[0], secondWorst = order[2], worst = order[3];
+
+        if (scores[worst].cost - scores[best].cost < options.tolerance)
+            break;
+
+        GainCandidate centroid{0.0, 0.0, 0.0};
+        for (size_t k = 0; k < 3; ++k)
+        {
+            centroid.Kp += simplex[order[k]].Kp / 3.0;
+            centroid.Ki += simplex[order[k]].Ki / 3.0;
+            centroid.Kd += simplex[order[k]].Kd / 3.0;
+        }
+
+        // Evaluate every point this iteration might accept at once
+        std::vector<GainCandidate> trial = {
+            lerp(centroid, simplex[worst], -alpha),         // reflection
+            lerp(centroid, simplex[worst], -alpha * gamma), // expansion
+            lerp(centroid, simplex[worst], -alpha * rho),   // outside contraction
+            lerp(centroid, simplex[worst], rho)};           // inside contraction
+        std::vector<LoopScore> trialScores = evaluateAll(trial);
+
+        const LoopScore &reflected = trialScores[0];
+        int accepted = -1;
+        if (reflected.cost < scores[best].cost)
+            accepted = trialScores[1].cost < reflected.cost ? 1 : 0;
+        else if (reflected.cost < scores[secondWorst].cost)
+            accepted = 0;
+        else if (reflected.cost < scores[worst].cost)
+            accepted = trialScores[2].cost <= reflected.cost ? 2 : -1;
+        else
+            accepted = trialScores[3].cost < scores[worst].cost ? 3 : -1;
+
+        if (accepted >= 0)
+        {
+            simplex[worst] = trial[accepted];
+            scores[worst] = trialScores[accepted];
+            continue;
+        }
+
+        // Shrink towards the best vertex
+        std::vector<GainCandidate> shrunk;
+        for (size_t k = 1; k < 4; ++k)
+            shrunk.push_back(lerp(simplex[best], simplex[order[k]], sigma));
+        std::vector<LoopScore> shrunkScores = evaluateAll(shrunk);
+        for (size_t k = 1; k < 4; ++k)
+        {
+            simplex[order[k]] = shrunk[k - 1];
+            scores[order[k]] = shrunkScores[k - 1];
+        }
+    }
+
+    size_t best = 0;
+    for (size_t k = 1; k < 4; ++k)
+        if (scores[k].cost < scores[best].cost)
+            best = k;
+
+    return {simplex[best], scores[best], evaluationCount - before};
+}
+
+std::optional<RelayResult> PIDAutoTuner::relayExperiment(double relayAmplitude, int steps) const
+{
+    std::unique_ptr<IPlant> plant = problem.makePlant();
+    const double dt = problem.sampleTime;
+
+    std::vector<double> crossings; // times the error turns from negative to non-negative
+    double previousError = 0.0;
+    double minOutput = 0.0, maxOutput = 0.0;
+    bool trackingAmplitude = false;
+
+    for (int step = 0; step < steps; ++step)
+    {
+        double output = plant->getOutput();
+        double error = problem.setpoint - output;
+        if (!std::isfinite(output))
+            return std::nullopt;
+
+        if (step > 0 && previousError < 0.0 && error >= 0.0)
+        {
+            crossings.push_back(step * dt);
+            // Skip the transient before the first full cycle
+            if (crossings.size() == 2)
+            {
+                trackingAmplitude = true;
+                minOutput = maxOutput = output;
+            }
+        }
+        if (trackingAmplitude)
+        {
+            minOutput = std::min(minOutput, output);
+            maxOutput = std::max(maxOutput, output);
+        }
+        previousError = error;
+
+        plant->update(error >= 0.0 ? relayAmplitude : -relayAmplitude);
+    }
+
+    if (crossings.size() < 3)
+        return std::nullopt;
+
+    double amplitude = 0.5 * (maxOutput - minOutput);
+    if (amplitude <= 0.0)
+        return std::nullopt;
+
+    // Average over the cycles after the transient
+    double period = (crossings.back() - crossings[1]) / static_cast<double>(crossings.size() - 2);
+    return RelayResult{4.0 * relayAmplitude / (pi * amplitude), period};
+}
+
+GainCandidate PIDAutoTuner::zieglerNichols(const RelayResult &relay) const
+{
+    const double dt = problem.sampleTime;
+
+    double Kp = 0.6 * relay.ultimateGain;
+    double Ti = relay.ultimatePeriod / 2.0;
+    double Td = relay.ultimatePeriod / 8.0;
+
+    // PID sums raw errors and differences raw errors, so fold dt into Ki and Kd
+    return project(Kp, Kp / Ti * dt, Kp * Td / dt);
+}
+
+TuningResult PIDAutoTuner::tune(double relayAmplitude)
+{
+    size_t before = evaluationCount;
+
+    // A coarse grid always provides a fallback seed; the relay seed replaces it when better
+    TuningResult seed = gridSearch({0.0, 10.0, 6}, {0.0, 1.0, 5}, {0.0, 5.0, 6});
+    if (std::optional<RelayResult> relay = relayExperiment(relayAmplitude, 10 * problem.steps))
+    {
+        GainCandidate zn = zieglerNichols(*relay);
+        LoopScore znScore = evaluateAll({zn})[0];
+        if (znScore.cost < seed.score.cost)
+            seed = {zn, znScore, 1};
+    }
+
+    TuningResult result = nelderMead(seed.gains);
+    result.evaluations = evaluationCount - before;
+    return result;
+}
+
+size_t PIDAutoTuner::evaluations() const
+{
+    return evaluationCount;
+}
@@ -0,0 +1,234 @@
+#include "PIDBank.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PIDBANK_X86 1
+#endif
+
+namespace
+{
+    struct Lanes
+    {
+        const double *Kp;
+        const double *Ki;
+        const double *Kd;
+        const double *antiWindupGain;
+        const double *outputMin;
+        const double *outputMax;
+        double *cumulativeError;
+        double *previousError;
+    };
+
+    // Same operation order as PID::control(), written with selects instead of branches.
+    void controlScalar(const Lanes &l, size_t i, size_t end, const double *errors, double *outputs)
+    {
+        for (; i < end; ++i)
+        {
+            double error = errors[i];
+            double P = error * l.Kp[i];
+            double proposedCumulativeError = l.cumulativeError[i] + error;
+            double I = proposedCumulativeError * l.Ki[i];
+            double D = (error - l.previousError[i]) * l.Kd[i];
+            l.previousError[i] = error;
+
+            double output = P + I + D;
+            double clampedOutput = l.outputMax[i] < output ? l.outputMax[i] : output;
+            clampedOutput = output < l.outputMin[i] ? l.outputMin[i] : clampedOutput;
+
+            double partialCumulativeError = l.cumulativeError[i] + error * (1.0 - l.antiWindupGain[i]);
+            l.cumulativeError[i] = output != clampedOutput ? partialCumulativeError : proposedCumulativeError;
+
+            outputs[i] = clampedOutput;
+        }
+    }
+
+#ifdef PIDBANK_X86
+    __attribute__((target("sse2"))) size_t controlSSE2(const Lanes &l, size_t i, size_t end, const double *errors, double *outputs)
+    {
+        const __m128d one = _mm_set1_pd(1.0);
+        for (; i + 2 <= end; i += 2)
+        {
+            __m128d error = _mm_loadu_pd(errors + i);
+            __m128d cumulative = _mm_loadu_pd(l.cumulativeError + i);
+
+            __m128d P = _mm_mul_pd(error, _mm_loadu_pd(l.Kp + i));
+            __m128d proposed = _mm_add_pd(cumulative, error);
+            __m128d I = _mm_mul_pd(proposed, _mm_loadu_pd(l.Ki + i));
+            __m128d D = _mm_mul_pd(_mm_sub_pd(error, _mm_loadu_pd(l.previousError + i)), _mm_loadu_pd(l.Kd + i));
+            _mm_storeu_pd(l.previousError + i, error);
+
+            __m128d output = _mm_add_pd(_mm_add_pd(P, I), D);
+            __m128d outMin = _mm_loadu_pd(l.outputMin + i);
+            __m128d outMax = _mm_loadu_pd(l.outputMax + i);
+
+            __m128d aboveMax = _mm_cmplt_pd(outMax, output);
+            __m128d clamped = _mm_or_pd(_mm_and_pd(aboveMax, outMax), _mm_andnot_pd(aboveMax, output));
+            __m128d belowMin = _mm_cmplt_pd(output, outMin);
+            clamped = _mm_or_pd(_mm_and_pd(belowMin, outMin), _mm_andnot_pd(belowMin, clamped));
+
+            __m128d partial = _mm_add_pd(cumulative, _mm_mul_pd(error, _mm_sub_pd(one, _mm_loadu_pd(l.antiWindupGain + i))));
+            __m128d saturated = _mm_cmpneq_pd(output, clamped);
+            _mm_storeu_pd(l.cumulativeError + i, _mm_or_pd(_mm_and_pd(saturated, partial), _mm_andnot_pd(saturated, proposed)));
+
+            _mm_storeu_pd(outputs + i, clamped);
+        }
+        return i;
+    }
+
+    __attribute__((target("avx2"))) size_t controlAVX2(const Lanes &l, size_t i, size_t end, const double *errors, double *outputs)
+    {
+        const __m256d one = _mm256_set1_pd(1.0);
+        for (; i + 4 <= end; i += 4)
+        {
+            __m256d error = _mm256_loadu_pd(errors + i);
+            __m256d cumulative = _mm256_loadu_pd(l.cumulativeError + i);
+
+            __m256d P = _mm256_mul_pd(error, _mm256_loadu_pd(l.Kp + i));
+            __m256d proposed = _mm256_add_pd(cumulative, error);
+            __m256d I = _mm256_mul_pd(proposed, _mm256_loadu_pd(l.Ki + i));
+            __m256d D = _mm256_mul_pd(_mm256_sub_pd(error, _mm256_loadu_pd(l.previousError + i)), _mm256_loadu_pd(l.Kd + i));
+            _mm256_storeu_pd(l.previousError + i, error);
+
+            __m256d output = _mm256_add_pd(_mm256_add_pd(P, I), D);
+            __m256d outMin = _mm256_loadu_pd(l.outputMin + i);
+            __m256d outMax = _mm256_loadu_pd(l.outputMax + i);
+
+            __m256d clamped = _mm256_blendv_pd(output, outMax, _mm256_cmp_pd(outMax, output, _CMP_LT_OQ));
+            clamped = _mm256_blendv_pd(clamped, outMin, _mm256_cmp_pd(output, outMin, _CMP_LT_OQ));
+
+            __m256d partial = _mm256_add_pd(cumulative, _mm256_mul_pd(error, _mm256_sub_pd(one, _mm256_loadu_pd(l.antiWindupGain + i))));
+            __m256d saturated = _mm256_cmp_pd(output, clamped, _CMP_NEQ_UQ);
+            _mm256_storeu_pd(l.cumulativeError + i, _mm256_blendv_pd(proposed, partial, saturated));
+
+            _mm256_storeu_pd(outputs + i, clamped);
+        }
+        return i;
+    }
+#endif
+}
+
+PIDBank::PIDBank() : m_kernel(bestKernel())
+{
+}
+
+PIDBank::PIDBank(size_t count, double Kp, double Ki, double Kd) : PIDBank()
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        addLoop(Kp, Ki, Kd);
+    }
+}
+
+size_t PIDBank::addLoop(double Kp, double Ki, double Kd)
+{
+    // Defaults mirror PID's constructor and member initialisers
+    m_Kp.push_back(Kp);
+    m_Ki.push_back(Ki);
+    m_Kd.push_back(Kd);
+    m_cumulativeError.push_back(0.0);
+    m_previousError.push_back(0.0);
+    m_antiWindupGain.push_back(1.0);
+    m_outputMin.push_back(-100.0);
+    m_outputMax.push_back(100.0);
+    return m_Kp.size() - 1;
+}
+
+size_t PIDBank::size() const
+{
+    return m_Kp.size();
+}
+
+void PIDBank::setKp(size_t loop, double kp)
+{
+    m_Kp[loop] = kp;
+}
+
+void PIDBank::setKi(size_t loop, double ki)
+{
+    m_Ki[loop] = ki;
+}
+
+void PIDBank::setKd(size_t loop, double kd)
+{
+    m_Kd[loop] = kd;
+}
+
+void PIDBank::setAntiWindupGain(size_t loop, double gain)
+{
+    m_antiWindupGain[loop] = gain;
+}
+
+void PIDBank::setOutputLimits(size_t loop, double min, double max)
+{
+    m_outputMin[loop] = min;
+    m_outputMax[loop] = max;
+}
+
+void PIDBank::reset()
+{
+    m_cumulativeError.assign(m_cumulativeError.size(), 0.0);
+    m_previousError.assign(m_previousError.size(), 0.0);
+}
+
+void PIDBank::reset(size_t loop)
+{
+    m_cumulativeError[loop] = 0.0;
+    m_previousError[loop] = 0.0;
+}
+
+void PIDBank::control(const double *errors, double *outputs)
+{
+    control(0, size(), errors, outputs);
+}
+
+void PIDBank::control(size_t first, size_t count, const double *errors, double *outputs)
+{
+    // Offset every column so that lane i of the kernels is loop first + i
+    Lanes lanes{m_Kp.data() + first, m_Ki.data() + first, m_Kd.data() + first,
+                m_antiWindupGain.data() + first, m_outputMin.data() + first, m_outputMax.data() + first,
+                m_cumulativeError.data() + first, m_previousError.data() + first};
+
+    size_t done = 0;
+#ifdef PIDBANK_X86
+    if (m_kernel == Kernel::AVX2)
+    {
+        done = controlAVX2(lanes, done, count, errors, outputs);
+    }
+    if (m_kernel != Kernel::Scalar)
+    {
+        done = controlSSE2(lanes, done, count, errors, outputs);
+    }
+#endif
+    controlScalar(lanes, done, count, errors, outputs);
+}
+
+void PIDBank::setKernel(Kernel kernel)
+{
+    m_kernel = static_cast<int>(kernel) > static_cast<int>(bestKernel()) ? bestKernel() : kernel;
+}
+
+PIDBank::Kernel PIDBank::kernel() const
+{
+    return m_kernel;
+}
+
+PIDBank::Kernel PIDBank::bestKernel()
+{
+#ifdef PIDBANK_X86
+    if (__builtin_cpu_supports("avx2"))
+        return Kernel::AVX2;
+    if (__builtin_cpu_supports("sse2"))
+        return Kernel::SSE2;
+#endif
+    return Kernel::Scalar;
+}
+
+double PIDBank::cumulativeError(size_t loop) const
+{
+    return m_cumulativeError[loop];
+}
+
+double PIDBank::previousError(size_t loop) const
+{
+    return m_previousError[loop];
+}
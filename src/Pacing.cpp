@@ -0,0 +1,80 @@
+#include "Pacing.h"
+#include <algorithm>
+#include <thread>
+
+Pacing::Pacing(double samplingPeriod, double speedup)
+    : m_samplingPeriod(samplingPeriod), m_speedup(speedup)
+{
+}
+
+Pacing Pacing::unthrottled(double samplingPeriod)
+{
+    return Pacing(samplingPeriod, 0.0);
+}
+
+Pacing Pacing::realtime(double samplingPeriod)
+{
+    return Pacing(samplingPeriod, 1.0);
+}
+
+Pacing Pacing::accelerated(double factor, double samplingPeriod)
+{
+    return Pacing(samplingPeriod, factor > 0.0 ? factor : 0.0);
+}
+
+double Pacing::samplingPeriod() const
+{
+    return m_samplingPeriod;
+}
+
+std::chrono::nanoseconds Pacing::wallPeriod() const
+{
+    if (!throttled())
+        return std::chrono::nanoseconds(0);
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(m_samplingPeriod / m_speedup));
+}
+
+bool Pacing::throttled() const
+{
+    return m_speedup > 0.0;
+}
+
+Pacer::Pacer(const Pacing &pacing) : m_pacing(pacing)
+{
+    restart();
+}
+
+void Pacer::restart()
+{
+    m_start = Clock::now();
+    m_stats = PacingStats();
+}
+
+std::chrono::nanoseconds Pacer::waitForNextStep()
+{
+    ++m_stats.steps;
+    if (!m_pacing.throttled())
+        return std::chrono::nanoseconds(0);
+
+    // Absolute deadline from the epoch, so errors never accumulate
+    Clock::time_point deadline = m_start + m_pacing.wallPeriod() * m_stats.steps;
+    Clock::time_point now = Clock::now();
+
+    if (now > deadline)
+    {
+        auto overrun = std::chrono::duration_cast<std::chrono::nanoseconds>(now - deadline);
+        ++m_stats.overruns;
+        m_stats.maxOverrun = std::max(m_stats.maxOverrun, overrun);
+        return overrun;
+    }
+
+    std::this_thread::sleep_until(deadline);
+    auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - deadline);
+    m_stats.maxWakeupLatency = std::max(m_stats.maxWakeupLatency, latency);
+    return latency;
+}
+
+const PacingStats &Pacer::stats() const
+{
+    return m_stats;
+}
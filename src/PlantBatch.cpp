@@ -0,0 +1,182 @@
+#include "PlantBatch.h"
+#include "VectorMath.h"
+
+// The loops below are written so that the compiler can vectorise them: the
+// columns are distinct vectors and each lane only touches its own elements.
+
+PositionSystemBatch::PositionSystemBatch(size_t count, double time_step)
+    : position_(count, 0.0), velocity_(count, 0.0), time_step_(count, time_step) {}
+
+void PositionSystemBatch::update(const double *controlSignals)
+{
+    double *__restrict position = position_.data();
+    double *__restrict velocity = velocity_.data();
+    const double *__restrict dt = time_step_.data();
+    const size_t n = size();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        velocity[i] += controlSignals[i] * dt[i];
+        position[i] += velocity[i] * dt[i];
+    }
+}
+
+size_t PositionSystemBatch::size() const
+{
+    return position_.size();
+}
+
+const double *PositionSystemBatch::outputs() const
+{
+    return position_.data();
+}
+
+double PositionSystemBatch::getOutput(size_t i) const
+{
+    return position_[i];
+}
+
+void PositionSystemBatch::setTimeStep(size_t i, double time_step)
+{
+    time_step_[i] = time_step;
+}
+
+void PositionSystemBatch::setState(size_t i, double position, double velocity)
+{
+    position_[i] = position;
+    velocity_[i] = velocity;
+}
+
+VelocitySystemBatch::VelocitySystemBatch(size_t count, double time_step)
+    : velocity_(count, 0.0), time_step_(count, time_step) {}
+
+void VelocitySystemBatch::update(const double *controlSignals)
+{
+    double *__restrict velocity = velocity_.data();
+    const double *__restrict dt = time_step_.data();
+    const size_t n = size();
+
+    for (size_t i = 0; i < n; ++i)
+        velocity[i] += controlSignals[i] * dt[i];
+}
+
+size_t VelocitySystemBatch::size() const
+{
+    return velocity_.size();
+}
+
+const double *VelocitySystemBatch::outputs() const
+{
+    return velocity_.data();
+}
+
+double VelocitySystemBatch::getOutput(size_t i) const
+{
+    return velocity_[i];
+}
+
+void VelocitySystemBatch::setTimeStep(size_t i, double time_step)
+{
+    time_step_[i] = time_step;
+}
+
+void VelocitySystemBatch::setState(size_t i, double velocity)
+{
+    velocity_[i] = velocity;
+}
+
+TemperatureSystemBatch::TemperatureSystemBatch(size_t count, double time_step)
+    : temperature_(count, 20.0), time_step_(count, time_step) {} // Assume ambient start temp
+
+void TemperatureSystemBatch::update(const double *controlSignals)
+{
+    double *__restrict temperature = temperature_.data();
+    const double *__restrict dt = time_step_.data();
+    const size_t n = size();
+
+    for (size_t i = 0; i < n; ++i)
+        temperature[i] += controlSignals[i] * dt[i];
+}
+
+size_t TemperatureSystemBatch::size() const
+{
+    return temperature_.size();
+}
+
+const double *TemperatureSystemBatch::outputs() const
+{
+    return temperature_.data();
+}
+
+double TemperatureSystemBatch::getOutput(size_t i) const
+{
+    return temperature_[i];
+}
+
+void TemperatureSystemBatch::setTimeStep(size_t i, double time_step)
+{
+    time_step_[i] = time_step;
+}
+
+void TemperatureSystemBatch::setState(size_t i, double temperature)
+{
+    temperature_[i] = temperature;
+}
+
+InvertedPendulumSystemBatch::InvertedPendulumSystemBatch(size_t count, double time_step)
+    : angle_(count, 0.1), angularVel_(count, 0.0), time_step_(count, time_step),
+      inertia_(count, 1.0), gravity_(count, 9.81), length_(count, 1.0), sinAngle_(count, 0.0) {}
+
+void InvertedPendulumSystemBatch::update(const double *controlSignals)
+{
+    const size_t n = size();
+    vectorSin(angle_.data(), sinAngle_.data(), n);
+
+    double *__restrict angle = angle_.data();
+    double *__restrict angularVel = angularVel_.data();
+    const double *__restrict sinAngle = sinAngle_.data();
+    const double *__restrict dt = time_step_.data();
+    const double *__restrict inertia = inertia_.data();
+    const double *__restrict gravity = gravity_.data();
+    const double *__restrict length = length_.data();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        double angularAcc = (controlSignals[i] - gravity[i] * sinAngle[i] * length[i]) / inertia[i];
+        angularVel[i] += angularAcc * dt[i];
+        angle[i] += angularVel[i] * dt[i];
+    }
+}
+
+size_t InvertedPendulumSystemBatch::size() const
+{
+    return angle_.size();
+}
+
+const double *InvertedPendulumSystemBatch::outputs() const
+{
+    return angle_.data();
+}
+
+double InvertedPendulumSystemBatch::getOutput(size_t i) const
+{
+    return angle_[i];
+}
+
+void InvertedPendulumSystemBatch::setTimeStep(size_t i, double time_step)
+{
+    time_step_[i] = time_step;
+}
+
+void InvertedPendulumSystemBatch::setState(size_t i, double angle, double angularVel)
+{
+    angle_[i] = angle;
+    angularVel_[i] = angularVel;
+}
+
+void InvertedPendulumSystemBatch::setParameters(size_t i, double inertia, double gravity, double length)
+{
+    inertia_[i] = inertia;
+    gravity_[i] = gravity;
+    length_[i] = length;
+}
@@ -0,0 +1,213 @@
+#include "PlotBuffer.h"
+#include <algorithm>
+#include <cmath>
+
+PlotRing::PlotRing(size_t capacity) : m_points(capacity > 0 ? capacity : 1) {}
+
+void PlotRing::push(PlotPoint point)
+{
+    size_t slot = (m_head + m_size) % m_points.size();
+    if (m_size == m_points.size())
+    {
+        // Full: overwrite the oldest point
+        const PlotPoint &evicted = m_points[m_head];
+        if (evicted.y <= m_minY || evicted.y >= m_maxY)
+            m_boundsStale = true;
+        m_head = (m_head + 1) % m_points.size();
+    }
+    else
+    {
+        ++m_size;
+    }
+
+    m_points[slot] = point;
+    if (m_size == 1)
+    {
+        m_minY = m_maxY = point.y;
+        m_boundsStale = false;
+    }
+    else
+    {
+        m_minY = std::min(m_minY, point.y);
+        m_maxY = std::max(m_maxY, point.y);
+    }
+
+    if (m_dirtyCount == 0)
+        m_dirtyFirst = slot;
+    m_dirtyCount = std::min(m_dirtyCount + 1, m_points.size());
+}
+
+void PlotRing::clear()
+{
+    m_head = 0;
+    m_size = 0;
+    m_dirtyCount = 0;
+    m_minY = m_maxY = 0.0f;
+    m_boundsStale = false;
+}
+
+size_t PlotRing::size() const
+{
+    return m_size;
+}
+
+size_t PlotRing::capacity() const
+{
+    return m_points.size();
+}
+
+const PlotPoint &PlotRing::operator[](size_t i) const
+{
+    return m_points[(m_head + i) % m_points.size()];
+}
+
+size_t PlotRing::head() const
+{
+    return m_head;
+}
+
+const PlotPoint *PlotRing::data() const
+{
+    return m_points.data();
+}
+
+float PlotRing::minY() const
+{
+    if (m_boundsStale)
+        recomputeBounds();
+    return m_minY;
+}
+
+float PlotRing::maxY() const
+{
+    if (m_boundsStale)
+        recomputeBounds();
+    return m_maxY;
+}
+
+void PlotRing::recomputeBounds() const
+{
+    m_minY = m_maxY = (*this)[0].y;
+    for (size_t i = 1; i < m_size; ++i)
+    {
+        m_minY = std::min(m_minY, (*this)[i].y);
+        m_maxY = std::max(m_maxY, (*this)[i].y);
+    }
+    m_boundsStale = false;
+}
+
+MinMaxDecimator::MinMaxDecimator(double columnWidth) : m_columnWidth(columnWidth > 0.0 ? columnWidth : 1.0) {}
+
+size_t MinMaxDecimator::add(double x, double y, PlotPoint out[2])
+{
+    long long column = static_cast<long long>(std::floor(x / m_columnWidth));
+    PlotPoint point{static_cast<float>(x), static_cast<float>(y)};
+
+    size_t emitted = 0;
+    if (m_open && column != m_column)
+    {
+        emitted = emit(out);
+        m_open = false;
+    }
+
+    if (!m_open)
+    {
+        m_open = true;
+        m_column = column;
+        m_min = m_max = point;
+    }
+    else if (point.y < m_min.y)
+        m_min = point;
+    else if (point.y > m_max.y)
+        m_max = point;
+
+    return emitted;
+}
+
+size_t MinMaxDecimator::flush(PlotPoint out[2])
+{
+    if (!m_open)
+        return 0;
+    m_open = false;
+    return emit(out);
+}
+
+size_t MinMaxDecimator::emit(PlotPoint out[2]) const
+{
+    if (m_min.x == m_max.x)
+    {
+        out[0] = m_min;
+        return 1;
+    }
+    // Keep time order so the line does not double back
+    out[0] = m_min.x < m_max.x ? m_min : m_max;
+    out[1] = m_min.x < m_max.x ? m_max : m_min;
+    return 2;
+}
+
+std::vector<PlotPoint> decimateMinMax(const std::vector<PlotPoint> &points, double columnWidth)
+{
+    std::vector<PlotPoint> result;
+    MinMaxDecimator decimator(columnWidth);
+    PlotPoint out[2];
+    for (const PlotPoint &p : points)
+    {
+        size_t n = decimator.add(p.x, p.y, out);
+        result.insert(result.end(), out, out + n);
+    }
+    size_t n = decimator.flush(out);
+    result.insert(result.end(), out, out + n);
+    return result;
+}
+
+std::vector<PlotPoint> decimateLttb(const std::vector<PlotPoint> &points, size_t threshold)
+{
+    if (threshold >= points.size() || threshold < 3)
+        return points;
+
+    std::vector<PlotPoint> result;
+    result.reserve(threshold);
+    result.push_back(points.front());
+
+    // The interior points are split into threshold - 2 buckets
+    const double bucketSize = static_cast<double>(points.size() - 2) / static_cast<double>(threshold - 2);
+    size_t selected = 0;
+
+    for (size_t bucket = 0; bucket < threshold - 2; ++bucket)
+    {
+        size_t first = static_cast<size_t>(std::floor(bucket * bucketSize)) + 1;
+        size_t last = static_cast<size_t>(std::floor((bucket + 1) * bucketSize)) + 1;
+
+        // Average of the next bucket (or the last point) as the third vertex
+        size_t nextFirst = last;
+        size_t nextLast = std::min(static_cast<size_t>(std::floor((bucket + 2) * bucketSize)) + 1, points.size());
+        double avgX = 0.0, avgY = 0.0;
+        for (size_t i = nextFirst; i < nextLast; ++i)
+        {
+            avgX += points[i].x;
+            avgY += points[i].y;
+        }
+        double nextCount = static_cast<double>(nextLast - nextFirst);
+        avgX /= nextCount;
+        avgY /= nextCount;
+
+        const PlotPoint &a = points[selected];
+        double largestArea = -1.0;
+        size_t best = first;
+        for (size_t i = first; i < last; ++i)
+        {
+            double area = std::fabs((a.x - avgX) * (points[i].y - a.y) - (a.x - points[i].x) * (avgY - a.y));
+            if (area > largestArea)
+            {
+                largestArea = area;
+                best = i;
+            }
+        }
+
+        result.push_back(points[best]);
+        selected = best;
+    }
+
+    result.push_back(points.back());
+    return result;
+}
@@ -0,0 +1,165 @@
+#include "RealtimeExecutor.h"
+#include <algorithm>
+#include <alloca.h>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+
+namespace
+{
+    constexpr long long nanosPerSecond = 1000000000LL;
+
+    timespec now()
+    {
+        timespec t;
+        clock_gettime(CLOCK_MONOTONIC, &t);
+        return t;
+    }
+
+    timespec add(timespec t, long long nanoseconds)
+    {
+        long long total = t.tv_nsec + nanoseconds;
+        t.tv_sec += static_cast<time_t>(total / nanosPerSecond);
+        t.tv_nsec = static_cast<long>(total % nanosPerSecond);
+        return t;
+    }
+
+    // a - b
+    std::chrono::nanoseconds difference(const timespec &a, const timespec &b)
+    {
+        return std::chrono::nanoseconds((static_cast<long long>(a.tv_sec) - b.tv_sec) * nanosPerSecond +
+                                        (a.tv_nsec - b.tv_nsec));
+    }
+
+    std::string failure(const char *what, int error)
+    {
+        return std::string(what) + " failed: " + std::strerror(error);
+    }
+
+    // Whether the process already holds locked pages (VmLck), e.g. from an earlier mlockall()
+    bool processHasLockedMemory()
+    {
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line))
+        {
+            if (line.compare(0, 6, "VmLck:") == 0)
+                return std::strtoll(line.c_str() + 6, nullptr, 10) > 0;
+        }
+        return false;
+    }
+
+    // Touch `bytes` of stack below the caller so later calls never fault on it
+    __attribute__((noinline)) void prefaultStack(size_t bytes)
+    {
+        volatile unsigned char *stack = static_cast<volatile unsigned char *>(alloca(bytes));
+        for (size_t i = 0; i < bytes; i += 4096)
+            stack[i] = 0;
+    }
+}
+
+DeadlineTimer::DeadlineTimer(std::chrono::nanoseconds period) : m_period(period)
+{
+    restart();
+}
+
+void DeadlineTimer::restart()
+{
+    m_start = now();
+    m_stats = PacingStats();
+}
+
+std::chrono::nanoseconds DeadlineTimer::waitForNextCycle()
+{
+    ++m_stats.steps;
+
+    // Absolute deadline from the epoch, so errors never accumulate
+    timespec deadline = add(m_start, m_period.count() * m_stats.steps);
+    std::chrono::nanoseconds late = difference(now(), deadline);
+    if (late.count() > 0)
+    {
+        ++m_stats.overruns;
+        m_stats.maxOverrun = std::max(m_stats.maxOverrun, late);
+        return late;
+    }
+
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR)
+    {
+    }
+    std::chrono::nanoseconds latency = difference(now(), deadline);
+    m_stats.maxWakeupLatency = std::max(m_stats.maxWakeupLatency, latency);
+    return latency;
+}
+
+const PacingStats &DeadlineTimer::stats() const
+{
+    return m_stats;
+}
+
+RealtimeExecutor::RealtimeExecutor(const RealtimeConfig &config) : m_config(config) {}
+
+const RealtimeSetup &RealtimeExecutor::setup() const
+{
+    return m_setup;
+}
+
+const RealtimeConfig &RealtimeExecutor::config() const
+{
+    return m_config;
+}
+
+void RealtimeExecutor::prepareThread()
+{
+    m_setup = RealtimeSetup();
+    m_unlockAfterRun = false;
+
+    if (m_config.cpu >= 0)
+    {
+#ifdef __linux__
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(m_config.cpu, &cpus);
+        int error = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+        m_setup.pinned = error == 0;
+        if (error != 0)
+            m_setup.warnings.push_back(failure("pthread_setaffinity_np", error));
+#else
+        m_setup.warnings.push_back("CPU pinning is not supported on this platform");
+#endif
+    }
+
+    // Lock before pre-faulting, so the touched stack pages stay resident
+    if (m_config.lockMemory)
+    {
+        bool lockedBefore = processHasLockedMemory();
+        m_setup.memoryLocked = mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+        if (!m_setup.memoryLocked)
+            m_setup.warnings.push_back(failure("mlockall", errno));
+        // Only undo a lock this run introduced
+        m_unlockAfterRun = m_setup.memoryLocked && !lockedBefore;
+    }
+
+    if (m_config.stackPrefault > 0)
+    {
+        prefaultStack(m_config.stackPrefault);
+        m_setup.stackPrefaulted = true;
+    }
+
+    sched_param param{};
+    param.sched_priority = std::clamp(m_config.priority, sched_get_priority_min(SCHED_FIFO), sched_get_priority_max(SCHED_FIFO));
+    int error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    m_setup.fifoScheduling = error == 0;
+    if (error != 0)
+        m_setup.warnings.push_back(failure("SCHED_FIFO", error) + "; running with the default scheduler");
+}
+
+void RealtimeExecutor::releaseMemory()
+{
+    if (m_unlockAfterRun)
+        munlockall();
+    m_unlockAfterRun = false;
+}
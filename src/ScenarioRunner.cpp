@@ -0,0 +1,139 @@
+#include "ScenarioRunner.h"
+#include "InvertedPendulumSystem.h"
+#include "PositionSystem.h"
+#include "Simulation.h"
+#include "TemperatureSystem.h"
+#include "VelocitySystem.h"
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+    template <typename Plant>
+    std::unique_ptr<IPlant> makePlant(double timeStep)
+    {
+        if (timeStep > 0.0)
+            return std::make_unique<Plant>(timeStep);
+        return std::make_unique<Plant>();
+    }
+
+    // Applies one optional key=value field of a scenario line
+    bool applyOption(const std::string &token, Scenario &scenario)
+    {
+        size_t equals = token.find('=');
+        if (equals == std::string::npos)
+            return false;
+
+        std::string key = token.substr(0, equals);
+        std::istringstream valueStream(token.substr(equals + 1));
+        double value;
+        if (!(valueStream >> value) || !valueStream.eof())
+            return false;
+
+        if (key == "dt")
+            scenario.timeStep = value;
+        else if (key == "antiwindup")
+            scenario.gains.antiWindupGain = value;
+        else if (key == "min")
+            scenario.gains.outputMin = value;
+        else if (key == "max")
+            scenario.gains.outputMax = value;
+        else
+            return false;
+        return true;
+    }
+}
+
+std::unique_ptr<IPlant> makeNamedPlant(const std::string &name, double timeStep)
+{
+    if (name == "position")
+        return makePlant<PositionSystem>(timeStep);
+    if (name == "velocity")
+        return makePlant<VelocitySystem>(timeStep);
+    if (name == "temperature")
+        return makePlant<TemperatureSystem>(timeStep);
+    if (name == "pendulum")
+        return makePlant<InvertedPendulumSystem>(timeStep);
+    return nullptr;
+}
+
+bool parseScenarios(std::istream &in, std::vector<Scenario> &scenarios, std::string &error)
+{
+    std::vector<Scenario> parsed;
+    std::string line;
+    for (int lineNumber = 1; std::getline(in, line); ++lineNumber)
+    {
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+
+        Scenario scenario;
+        if (!(fields >> scenario.name))
+            continue; // blank or comment-only line
+
+        auto fail = [&](const std::string &why)
+        {
+            error = "line " + std::to_string(lineNumber) + ": " + why;
+            return false;
+        };
+
+        if (!(fields >> scenario.plant >> scenario.setpoint >> scenario.steps
+                    >> scenario.gains.Kp >> scenario.gains.Ki >> scenario.gains.Kd))
+            return fail("expected: name plant setpoint steps Kp Ki Kd");
+        if (!makeNamedPlant(scenario.plant))
+            return fail("unknown plant '" + scenario.plant + "'");
+        if (scenario.steps < 0)
+            return fail("negative step count");
+
+        std::string option;
+        while (fields >> option)
+            if (!applyOption(option, scenario))
+                return fail("bad option '" + option + "'");
+
+        parsed.push_back(scenario);
+    }
+
+    scenarios = std::move(parsed);
+    return true;
+}
+
+bool loadScenarios(const std::string &path, std::vector<Scenario> &scenarios, std::string &error)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        error = "cannot open " + path;
+        return false;
+    }
+    return parseScenarios(file, scenarios, error);
+}
+
+ScenarioRunner::ScenarioRunner(ThreadPool &pool, const Pacing &pacing) : pool(pool), pacing(pacing) {}
+
+ScenarioResult ScenarioRunner::run(const Scenario &scenario) const
+{
+    ScenarioResult result;
+    result.name = scenario.name;
+
+    std::unique_ptr<IPlant> plant = makeNamedPlant(scenario.plant, scenario.timeStep);
+    if (!plant)
+        return result;
+
+    // A fresh controller per run: nothing carries over from other scenarios
+    BasicPID<double> pid;
+    pid.applyGains(scenario.gains);
+
+    result.samples.reserve(static_cast<size_t>(scenario.steps));
+    result.pacing = simulate(*plant, pid, scenario.setpoint, scenario.steps, pacing,
+                             [&](const StepSample &sample)
+                             { result.samples.push_back(sample); });
+    return result;
+}
+
+std::vector<ScenarioResult> ScenarioRunner::runAll(const std::vector<Scenario> &scenarios)
+{
+    // Each task writes only its own slot, so the merge is just the input order
+    std::vector<ScenarioResult> results(scenarios.size());
+    pool.parallelFor(scenarios.size(), [&](size_t i)
+                     { results[i] = run(scenarios[i]); });
+    return results;
+}
@@ -0,0 +1,351 @@
+#include "StringKernels.h"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define STRINGKERNELS_X86 1
+#endif
+
+namespace
+{
+    // Every kernel handles whole vectors and returns where it stopped; the
+    // scalar versions below finish the tail (or do the whole job).
+
+    size_t findScalar(const char *str, size_t size, char c, size_t i)
+    {
+        for (; i < size; ++i)
+        {
+            if (str[i] == c)
+                return i;
+        }
+        return stringNpos;
+    }
+
+    size_t findScalar(const char *str, size_t size, const char *needle, size_t needleSize, size_t i)
+    {
+        for (; i + needleSize <= size; ++i)
+        {
+            if (str[i] == needle[0] && std::memcmp(str + i, needle, needleSize) == 0)
+                return i;
+        }
+        return stringNpos;
+    }
+
+    int compareByte(char a, char b)
+    {
+        return static_cast<int>(static_cast<unsigned char>(a)) - static_cast<int>(static_cast<unsigned char>(b));
+    }
+
+#ifdef STRINGKERNELS_X86
+    // First differing position in [0, size) as found 32 bytes at a time; `size` if none
+    __attribute__((target("avx2"))) size_t mismatchAVX2(const char *a, const char *b, size_t size, size_t &i)
+    {
+        for (; i + 32 <= size; i += 32)
+        {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+            __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+            unsigned equal = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+            if (equal != 0xFFFFFFFFu)
+                return i + static_cast<size_t>(__builtin_ctz(~equal));
+        }
+        return size;
+    }
+
+    __attribute__((target("sse4.2"))) size_t mismatchSSE42(const char *a, const char *b, size_t size, size_t &i)
+    {
+        for (; i + 16 <= size; i += 16)
+        {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+            __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+            unsigned equal = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)));
+            if (equal != 0xFFFFu)
+                return i + static_cast<size_t>(__builtin_ctz(~equal & 0xFFFFu));
+        }
+        return size;
+    }
+
+    __attribute__((target("avx2"))) size_t findAVX2(const char *str, size_t size, char c, size_t &i)
+    {
+        const __m256i target = _mm256_set1_epi8(c);
+        for (; i + 32 <= size; i += 32)
+        {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(str + i));
+            unsigned hits = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, target)));
+            if (hits)
+                return i + static_cast<size_t>(__builtin_ctz(hits));
+        }
+        return stringNpos;
+    }
+
+    __attribute__((target("sse4.2"))) size_t findSSE42(const char *str, size_t size, char c, size_t &i)
+    {
+        const __m128i target = _mm_set1_epi8(c);
+        for (; i + 16 <= size; i += 16)
+        {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(str + i));
+            unsigned hits = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, target)));
+            if (hits)
+                return i + static_cast<size_t>(__builtin_ctz(hits));
+        }
+        return stringNpos;
+    }
+
+    // Compares the needle's first and last characters at 32 candidate positions
+    // at once and only verifies the positions where both match (W. Muła)
+    __attribute__((target("avx2"))) size_t findAVX2(const char *str, size_t size, const char *needle, size_t needleSize, size_t &i)
+    {
+        const __m256i first = _mm256_set1_epi8(needle[0]);
+        const __m256i last = _mm256_set1_epi8(needle[needleSize - 1]);
+        for (; i + needleSize - 1 + 32 <= size; i += 32)
+        {
+            __m256i head = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(str + i));
+            __m256i tail = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(str + i + needleSize - 1));
+            unsigned candidates = static_cast<unsigned>(_mm256_movemask_epi8(
+                _mm256_and_si256(_mm256_cmpeq_epi8(head, first), _mm256_cmpeq_epi8(tail, last))));
+            while (candidates)
+            {
+                size_t position = i + static_cast<size_t>(__builtin_ctz(candidates));
+                if (std::memcmp(str + position + 1, needle + 1, needleSize - 2) == 0)
+                    return position;
+                candidates &= candidates - 1;
+            }
+        }
+        return stringNpos;
+    }
+
+    // PCMPESTRI in "equal ordered" mode reports the first offset in a 16-byte
+    // block where the needle's first 16 bytes match, a prefix running off the
+    // end of the block included; longer needles are then verified with memcmp
+    __attribute__((target("sse4.2"))) size_t findSSE42(const char *str, size_t size, const char *needle, size_t needleSize, size_t &i)
+    {
+        // Copied so the load never reads past a short needle
+        alignas(16) char prefix[16] = {};
+        int prefixSize = static_cast<int>(needleSize < 16 ? needleSize : 16);
+        std::memcpy(prefix, needle, static_cast<size_t>(prefixSize));
+        const __m128i pattern = _mm_load_si128(reinterpret_cast<const __m128i *>(prefix));
+
+        while (i + 16 <= size)
+        {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(str + i));
+            int offset = _mm_cmpestri(pattern, prefixSize, block, 16, _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ORDERED);
+            if (offset == 16)
+            {
+                i += 16;
+                continue;
+            }
+
+            size_t position = i + static_cast<size_t>(offset);
+            if (position + needleSize > size)
+            {
+                // No later position fits either
+                i = size;
+                return stringNpos;
+            }
+            if (std::memcmp(str + position, needle, needleSize) == 0)
+                return position;
+            i = position + 1;
+        }
+        return stringNpos;
+    }
+#endif
+
+    uint64_t read8(const char *p)
+    {
+        uint64_t v;
+        std::memcpy(&v, p, 8);
+        return v;
+    }
+
+    uint64_t read4(const char *p)
+    {
+        uint32_t v;
+        std::memcpy(&v, p, 4);
+        return v;
+    }
+
+    // 1 to 3 bytes: first, middle and last, which may overlap
+    uint64_t read3(const char *p, size_t size)
+    {
+        auto byte = [](char c)
+        { return static_cast<uint64_t>(static_cast<unsigned char>(c)); };
+        return (byte(p[0]) << 16) | (byte(p[size >> 1]) << 8) | byte(p[size - 1]);
+    }
+
+    // 64x64 -> 128-bit multiply, folded back to 64 bits
+    uint64_t mix(uint64_t a, uint64_t b)
+    {
+        __uint128_t product = static_cast<__uint128_t>(a) * b;
+        return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+    }
+
+    constexpr uint64_t P0 = 0xa0761d6478bd642fULL;
+    constexpr uint64_t P1 = 0xe7037ed1a0b428dbULL;
+    constexpr uint64_t P2 = 0x8ebc6af09c88c6e3ULL;
+    constexpr uint64_t P3 = 0x589965cc75374cc3ULL;
+}
+
+StringKernel bestStringKernel()
+{
+    static const StringKernel best = []()
+    {
+#ifdef STRINGKERNELS_X86
+        if (__builtin_cpu_supports("avx2"))
+            return StringKernel::AVX2;
+        if (__builtin_cpu_supports("sse4.2"))
+            return StringKernel::SSE42;
+#endif
+        return StringKernel::Scalar;
+    }();
+    return best;
+}
+
+bool stringEqual(const char *a, const char *b, size_t size)
+{
+    return stringEqual(a, b, size, bestStringKernel());
+}
+
+bool stringEqual(const char *a, const char *b, size_t size, StringKernel kernel)
+{
+    return stringCompare(a, b, size, kernel) == 0;
+}
+
+int stringCompare(const char *a, const char *b, size_t size)
+{
+    return stringCompare(a, b, size, bestStringKernel());
+}
+
+int stringCompare(const char *a, const char *b, size_t size, StringKernel kernel)
+{
+    size_t i = 0;
+#ifdef STRINGKERNELS_X86
+    size_t mismatch = size;
+    if (kernel == StringKernel::AVX2 && bestStringKernel() == StringKernel::AVX2)
+        mismatch = mismatchAVX2(a, b, size, i);
+    if (mismatch == size && kernel != StringKernel::Scalar && bestStringKernel() != StringKernel::Scalar)
+        mismatch = mismatchSSE42(a, b, size, i);
+    if (mismatch != size)
+        return compareByte(a[mismatch], b[mismatch]);
+#else
+    (void)kernel;
+#endif
+    for (; i < size; ++i)
+    {
+        if (a[i] != b[i])
+            return compareByte(a[i], b[i]);
+    }
+    return 0;
+}
+
+size_t stringFind(const char *str, size_t size, char c)
+{
+    return stringFind(str, size, c, bestStringKernel());
+}
+
+size_t stringFind(const char *str, size_t size, char c, StringKernel kernel)
+{
+    size_t i = 0;
+#ifdef STRINGKERNELS_X86
+    size_t found = stringNpos;
+    if (kernel == StringKernel::AVX2 && bestStringKernel() == StringKernel::AVX2)
+        found = findAVX2(str, size, c, i);
+    if (found == stringNpos && kernel != StringKernel::Scalar && bestStringKernel() != StringKernel::Scalar)
+        found = findSSE42(str, size, c, i);
+    if (found != stringNpos)
+        return found;
+#else
+    (void)kernel;
+#endif
+    return findScalar(str, size, c, i);
+}
+
+size_t stringFind(const char *str, size_t size, const char *needle, size_t needleSize)
+{
+    return stringFind(str, size, needle, needleSize, bestStringKernel());
+}
+
+size_t stringFind(const char *str, size_t size, const char *needle, size_t needleSize, StringKernel kernel)
+{
+    if (needleSize == 0)
+        return 0;
+    if (needleSize > size)
+        return stringNpos;
+    if (needleSize == 1)
+        return stringFind(str, size, needle[0], kernel);
+
+    size_t i = 0;
+#ifdef STRINGKERNELS_X86
+    if (kernel == StringKernel::AVX2 && bestStringKernel() == StringKernel::AVX2)
+    {
+        size_t found = findAVX2(str, size, needle, needleSize, i);
+        if (found != stringNpos)
+            return found;
+    }
+    else if (kernel == StringKernel::SSE42 && bestStringKernel() != StringKernel::Scalar)
+    {
+        size_t found = findSSE42(str, size, needle, needleSize, i);
+        if (found != stringNpos)
+            return found;
+    }
+#else
+    (void)kernel;
+#endif
+    return findScalar(str, size, needle, needleSize, i);
+}
+
+uint64_t stringHash(const char *str, size_t size, uint64_t seed)
+{
+    const char *p = str;
+    seed ^= mix(seed ^ P0, P1);
+
+    uint64_t a, b;
+    if (size <= 16)
+    {
+        if (size >= 4)
+        {
+            // Two overlapping 4-byte reads from each end cover 4..16 bytes
+            size_t step = (size >> 3) << 2;
+            a = (read4(p) << 32) | read4(p + step);
+            b = (read4(p + size - 4) << 32) | read4(p + size - 4 - step);
+        }
+        else if (size > 0)
+        {
+            a = read3(p, size);
+            b = 0;
+        }
+        else
+        {
+            a = b = 0;
+        }
+    }
+    else
+    {
+        size_t remaining = size;
+        if (remaining > 48)
+        {
+            // Three independent lanes keep the multipliers busy
+            uint64_t lane1 = seed, lane2 = seed;
+            do
+            {
+                seed = mix(read8(p) ^ P1, read8(p + 8) ^ seed);
+                lane1 = mix(read8(p + 16) ^ P2, read8(p + 24) ^ lane1);
+                lane2 = mix(read8(p + 32) ^ P3, read8(p + 40) ^ lane2);
+                p += 48;
+                remaining -= 48;
+            } while (remaining > 48);
+            seed ^= lane1 ^ lane2;
+        }
+        while (remaining > 16)
+        {
+            seed = mix(read8(p) ^ P1, read8(p + 8) ^ seed);
+            p += 16;
+            remaining -= 16;
+        }
+        // The last 16 bytes, overlapping what was already mixed if need be
+        a = read8(p + remaining - 16);
+        b = read8(p + remaining - 8);
+    }
+
+    a ^= P1;
+    b ^= seed;
+    return mix(P1 ^ size, mix(a, b));
+}
@@ -0,0 +1,148 @@
+#include "Telemetry.h"
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <ostream>
+
+namespace
+{
+    const char magic[8] = {'P', 'I', 'D', 'T', 'L', 'M', '1', '\0'};
+    constexpr uint32_t recordSize = sizeof(StepSample);
+
+    static_assert(sizeof(StepSample) == sizeof(long long) + 5 * sizeof(double), "StepSample must be packed");
+
+    // How long the writer sleeps when it finds the ring empty
+    constexpr std::chrono::milliseconds idlePoll(1);
+}
+
+TelemetryLogger::TelemetryLogger(const std::string &path, size_t capacity, size_t batchSize)
+    : m_ring(capacity), m_file(path, std::ios::binary | std::ios::trunc), m_batchSize(batchSize > 0 ? batchSize : 1)
+{
+    if (!m_file)
+        return;
+
+    uint32_t header[2] = {recordSize, 0};
+    m_file.write(magic, sizeof(magic));
+    m_file.write(reinterpret_cast<const char *>(header), sizeof(header));
+
+    m_open = true;
+    m_writer = std::thread(&TelemetryLogger::writerLoop, this);
+}
+
+TelemetryLogger::~TelemetryLogger()
+{
+    close();
+}
+
+bool TelemetryLogger::isOpen() const
+{
+    return m_open;
+}
+
+bool TelemetryLogger::record(const StepSample &sample)
+{
+    // Single producer: plain load/store keeps the counters off the lock-prefixed path
+    if (m_open && !m_stopping.load(std::memory_order_relaxed) && m_ring.tryPush(sample))
+    {
+        m_recorded.store(m_recorded.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return true;
+    }
+    m_dropped.store(m_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    return false;
+}
+
+void TelemetryLogger::close()
+{
+    m_stopping.store(true, std::memory_order_release);
+    if (m_writer.joinable())
+        m_writer.join();
+}
+
+long long TelemetryLogger::recorded() const
+{
+    return m_recorded.load(std::memory_order_relaxed);
+}
+
+long long TelemetryLogger::dropped() const
+{
+    return m_dropped.load(std::memory_order_relaxed);
+}
+
+long long TelemetryLogger::written() const
+{
+    return m_written.load(std::memory_order_relaxed);
+}
+
+bool TelemetryLogger::writeFailed() const
+{
+    return m_writeFailed.load(std::memory_order_relaxed);
+}
+
+void TelemetryLogger::writerLoop()
+{
+    std::vector<StepSample> batch(m_batchSize);
+
+    for (;;)
+    {
+        // Read the flag before draining so nothing pushed before close() is missed
+        bool stopping = m_stopping.load(std::memory_order_acquire);
+
+        size_t count = m_ring.popBatch(batch.data(), batch.size());
+        if (count > 0)
+        {
+            m_file.write(reinterpret_cast<const char *>(batch.data()), static_cast<std::streamsize>(count * recordSize));
+            if (m_file)
+                m_written.fetch_add(static_cast<long long>(count), std::memory_order_relaxed);
+            else
+                m_writeFailed.store(true, std::memory_order_relaxed);
+            continue;
+        }
+
+        if (stopping)
+            break;
+        std::this_thread::sleep_for(idlePoll);
+    }
+
+    if (!m_file.flush())
+        m_writeFailed.store(true, std::memory_order_relaxed);
+}
+
+bool readTelemetry(const std::string &path, std::vector<StepSample> &samples)
+{
+    std::ifstream file(path, std::ios::binary);
+    char fileMagic[sizeof(magic)];
+    uint32_t header[2];
+    if (!file.read(fileMagic, sizeof(fileMagic)) || !file.read(reinterpret_cast<char *>(header), sizeof(header)))
+        return false;
+    if (std::memcmp(fileMagic, magic, sizeof(magic)) != 0 || header[0] != recordSize)
+        return false;
+
+    samples.clear();
+    StepSample sample;
+    while (file.read(reinterpret_cast<char *>(&sample), recordSize))
+        samples.push_back(sample);
+    return true;
+}
+
+void writeTelemetryCsv(const std::vector<StepSample> &samples, std::ostream &out)
+{
+    auto precision = out.precision(std::numeric_limits<double>::max_digits10);
+    out << "step,setpoint,output,error,control,response\n";
+    for (const StepSample &s : samples)
+        out << s.step << ',' << s.setpoint << ',' << s.output << ',' << s.error << ','
+            << s.control << ',' << s.response << '\n';
+    out.precision(precision);
+}
+
+bool exportTelemetryCsv(const std::string &binaryPath, const std::string &csvPath)
+{
+    std::vector<StepSample> samples;
+    if (!readTelemetry(binaryPath, samples))
+        return false;
+
+    std::ofstream csv(csvPath);
+    writeTelemetryCsv(samples, csv);
+    return static_cast<bool>(csv);
+}
@@ -1,15 +1,19 @@
 #include "TemperatureSystem.h"
 
 TemperatureSystem::TemperatureSystem(double time_step)
-    : temperature_(20.0), time_step_(time_step) {} // Assume ambient start temp
+    : system_(time_step) {}
 
 double TemperatureSystem::update(double controlSignal)
 {
-    temperature_ += controlSignal * time_step_;
-    return temperature_;
+    return system_.update(controlSignal);
+}
+
+double TemperatureSystem::advance(double controlSignal, long long nSteps)
+{
+    return system_.advance(controlSignal, nSteps);
 }
 
 double TemperatureSystem::getOutput() const
 {
-    return temperature_;
+    return system_.getOutput();
 }
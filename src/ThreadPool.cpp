@@ -0,0 +1,116 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+namespace
+{
+    // Identifies the pool and deque of the current thread, if it is a worker.
+    thread_local const ThreadPool *currentPool = nullptr;
+    thread_local size_t currentWorker = 0;
+}
+
+ThreadPool::ThreadPool(size_t threadCount)
+{
+    if (threadCount == 0)
+        threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+
+    for (size_t i = 0; i < threadCount; ++i)
+        workers.push_back(std::make_unique<Worker>());
+
+    for (size_t i = 0; i < threadCount; ++i)
+        threads.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping.store(true);
+    }
+    wakeUp.notify_all();
+
+    for (std::thread &t : threads)
+        t.join();
+}
+
+size_t ThreadPool::size() const
+{
+    return workers.size();
+}
+
+void ThreadPool::submit(Task task)
+{
+    size_t target = currentPool == this ? currentWorker
+                                        : nextWorker.fetch_add(1, std::memory_order_relaxed) % workers.size();
+    {
+        std::lock_guard<std::mutex> lock(workers[target]->mutex);
+        workers[target]->tasks.push_back(std::move(task));
+    }
+    queued.fetch_add(1, std::memory_order_release);
+
+    // Taking the lock orders the notification after a worker's check-then-wait
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wakeUp.notify_one();
+}
+
+bool ThreadPool::popOwn(size_t index, Task &task)
+{
+    Worker &worker = *workers[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.tasks.empty())
+        return false;
+
+    task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::steal(size_t thief, Task &task)
+{
+    for (size_t offset = 1; offset <= workers.size(); ++offset)
+    {
+        Worker &victim = *workers[(thief + offset) % workers.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::runPendingTask()
+{
+    if (queued.load(std::memory_order_acquire) == 0)
+        return false;
+
+    Task task;
+    size_t self = currentPool == this ? currentWorker : 0;
+    if (!(currentPool == this && popOwn(self, task)) && !steal(self, task))
+        return false;
+
+    queued.fetch_sub(1, std::memory_order_relaxed);
+    task();
+    return true;
+}
+
+void ThreadPool::workerLoop(size_t index)
+{
+    currentPool = this;
+    currentWorker = index;
+
+    while (true)
+    {
+        if (runPendingTask())
+            continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeUp.wait(lock, [this]()
+                    { return stopping.load() || queued.load(std::memory_order_acquire) != 0; });
+        if (stopping.load() && queued.load() == 0)
+            return;
+    }
+}
@@ -0,0 +1,264 @@
+#include "TraceFile.h"
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+    const char magic[8] = {'P', 'I', 'D', 'T', 'R', 'A', 'C', 'E'};
+    constexpr uint64_t version = 1;
+    constexpr size_t headerSize = 64;
+    constexpr size_t columns = 6;
+    constexpr size_t indexEntryWords = 3;
+    constexpr size_t initialSize = 1 << 20;
+
+    struct Header
+    {
+        char magic[8];
+        uint64_t version;
+        uint64_t runCount;
+        uint64_t indexOffset;
+    };
+    static_assert(sizeof(Header) <= headerSize, "header must fit its slot");
+}
+
+StepSample TraceRun::sample(size_t k) const
+{
+    return {step[k], setpoint[k], output[k], error[k], control[k], response[k]};
+}
+
+TraceWriter::TraceWriter(const std::string &path)
+{
+    m_fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (m_fd < 0)
+        return;
+
+    m_used = headerSize;
+    if (!reserve(initialSize))
+    {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+TraceWriter::~TraceWriter()
+{
+    close();
+}
+
+bool TraceWriter::isOpen() const
+{
+    return m_fd >= 0;
+}
+
+bool TraceWriter::reserve(size_t bytes)
+{
+    if (bytes <= m_mappedSize)
+        return true;
+
+    size_t newSize = m_mappedSize > 0 ? m_mappedSize : initialSize;
+    while (newSize < bytes)
+    {
+        if (newSize > SIZE_MAX / 2)
+            return false;
+        newSize *= 2;
+    }
+
+    if (::ftruncate(m_fd, static_cast<off_t>(newSize)) != 0)
+        return false;
+
+    // Remap rather than mremap, which is Linux-only
+    void *map = ::mmap(nullptr, newSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (map == MAP_FAILED)
+        return false;
+    if (m_map)
+        ::munmap(m_map, m_mappedSize);
+
+    m_map = static_cast<unsigned char *>(map);
+    m_mappedSize = newSize;
+    return true;
+}
+
+double *TraceWriter::column(size_t c) const
+{
+    return reinterpret_cast<double *>(m_map + m_run.offset + c * m_run.capacity * sizeof(double));
+}
+
+bool TraceWriter::beginRun(size_t capacity)
+{
+    // The run's size in bytes must not wrap around
+    if (capacity > (SIZE_MAX - m_used) / columns / sizeof(double))
+        return false;
+    if (!isOpen() || m_runOpen || !reserve(m_used + columns * capacity * sizeof(double)))
+        return false;
+
+    m_run = {m_used, capacity, 0};
+    m_runOpen = true;
+    return true;
+}
+
+void TraceWriter::operator()(const StepSample &sample)
+{
+    if (!m_runOpen || m_run.steps >= m_run.capacity)
+        return;
+
+    size_t k = m_run.steps++;
+    reinterpret_cast<int64_t *>(column(0))[k] = sample.step;
+    column(1)[k] = sample.setpoint;
+    column(2)[k] = sample.output;
+    column(3)[k] = sample.error;
+    column(4)[k] = sample.control;
+    column(5)[k] = sample.response;
+}
+
+void TraceWriter::endRun()
+{
+    if (!m_runOpen)
+        return;
+
+    m_used += columns * m_run.capacity * sizeof(double);
+    m_index.push_back(m_run);
+    m_runOpen = false;
+}
+
+bool TraceWriter::appendRun(const std::vector<StepSample> &samples)
+{
+    if (!beginRun(samples.size()))
+        return false;
+    for (const StepSample &sample : samples)
+        (*this)(sample);
+    endRun();
+    return true;
+}
+
+size_t TraceWriter::runCount() const
+{
+    return m_index.size();
+}
+
+bool TraceWriter::close()
+{
+    if (!isOpen())
+        return false;
+
+    endRun();
+
+    size_t indexOffset = m_used;
+    size_t indexBytes = m_index.size() * sizeof(IndexEntry);
+    bool ok = reserve(indexOffset + indexBytes);
+    if (ok)
+    {
+        std::memcpy(m_map + indexOffset, m_index.data(), indexBytes);
+        m_used += indexBytes;
+
+        Header header;
+        std::memcpy(header.magic, magic, sizeof(magic));
+        header.version = version;
+        header.runCount = m_index.size();
+        header.indexOffset = indexOffset;
+        std::memset(m_map, 0, headerSize);
+        std::memcpy(m_map, &header, sizeof(header));
+    }
+
+    if (m_map)
+        ::munmap(m_map, m_mappedSize);
+    ok = ok && ::ftruncate(m_fd, static_cast<off_t>(m_used)) == 0;
+    ok = ::close(m_fd) == 0 && ok;
+
+    m_map = nullptr;
+    m_mappedSize = 0;
+    m_fd = -1;
+    m_index.clear();
+    return ok;
+}
+
+TraceReader::TraceReader(const std::string &path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return;
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < headerSize)
+    {
+        ::close(fd);
+        return;
+    }
+
+    size_t size = static_cast<size_t>(info.st_size);
+    void *map = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // the mapping keeps the file alive
+    if (map == MAP_FAILED)
+        return;
+
+    m_map = static_cast<const unsigned char *>(map);
+    m_size = size;
+
+    Header header;
+    std::memcpy(&header, m_map, sizeof(header));
+    // The index and the columns are read in place as 8-byte values: their
+    // offsets must be multiples of 8 (the mapping itself is page aligned)
+    bool valid = std::memcmp(header.magic, magic, sizeof(magic)) == 0 && header.version == version &&
+                 header.indexOffset >= headerSize && header.indexOffset <= size &&
+                 header.indexOffset % sizeof(uint64_t) == 0 &&
+                 header.runCount <= (size - header.indexOffset) / (indexEntryWords * sizeof(uint64_t));
+
+    const uint64_t *index = valid ? reinterpret_cast<const uint64_t *>(m_map + header.indexOffset) : nullptr;
+    for (size_t i = 0; valid && i < header.runCount; ++i)
+    {
+        uint64_t offset = index[i * indexEntryWords], capacity = index[i * indexEntryWords + 1];
+        uint64_t steps = index[i * indexEntryWords + 2];
+        valid = steps <= capacity && offset >= headerSize && offset <= header.indexOffset &&
+                offset % sizeof(double) == 0 &&
+                capacity <= (header.indexOffset - offset) / (columns * sizeof(double));
+    }
+
+    if (!valid)
+    {
+        ::munmap(const_cast<unsigned char *>(m_map), m_size);
+        m_map = nullptr;
+        m_size = 0;
+        return;
+    }
+
+    m_runCount = header.runCount;
+    m_index = index;
+}
+
+TraceReader::~TraceReader()
+{
+    if (m_map)
+        ::munmap(const_cast<unsigned char *>(m_map), m_size);
+}
+
+bool TraceReader::isOpen() const
+{
+    return m_map != nullptr;
+}
+
+size_t TraceReader::runCount() const
+{
+    return m_runCount;
+}
+
+TraceRun TraceReader::run(size_t i) const
+{
+    const uint64_t *entry = m_index + i * indexEntryWords;
+    const unsigned char *base = m_map + entry[0];
+    size_t capacity = entry[1], steps = entry[2];
+
+    auto column = [&](size_t c)
+    { return reinterpret_cast<const double *>(base + c * capacity * sizeof(double)); };
+
+    TraceRun run;
+    run.step = Column<int64_t>(reinterpret_cast<const int64_t *>(column(0)), steps);
+    run.setpoint = Column<double>(column(1), steps);
+    run.output = Column<double>(column(2), steps);
+    run.error = Column<double>(column(3), steps);
+    run.control = Column<double>(column(4), steps);
+    run.response = Column<double>(column(5), steps);
+    return run;
+}
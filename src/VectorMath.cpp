@@ -0,0 +1,158 @@
+#include "VectorMath.h"
+#include <cmath>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define VECTORMATH_X86 1
+#endif
+
+namespace
+{
+    // pi/4 split into three parts for an exact Cody-Waite reduction
+    constexpr double DP1 = 7.85398125648498535156E-1;
+    constexpr double DP2 = 3.77489470793079817668E-8;
+    constexpr double DP3 = 2.69515142907905952645E-15;
+    constexpr double fourOverPi = 1.27323954473516268615;
+
+    // Beyond this the octant no longer fits in an int32 and the reduction loses
+    // accuracy; such arguments (and inf/NaN) go to std::sin instead
+    constexpr double reductionLimit = 1e9;
+
+    constexpr double S0 = 1.58962301576546568060E-10;
+    constexpr double S1 = -2.50507477628578072866E-8;
+    constexpr double S2 = 2.75573136213857245213E-6;
+    constexpr double S3 = -1.98412698295895385996E-4;
+    constexpr double S4 = 8.33333333332211858878E-3;
+    constexpr double S5 = -1.66666666666666307295E-1;
+
+    constexpr double C0 = -1.13585365213876817300E-11;
+    constexpr double C1 = 2.08757008419747316778E-9;
+    constexpr double C2 = -2.75573141792967388112E-7;
+    constexpr double C3 = 2.48015872888517045348E-5;
+    constexpr double C4 = -1.38888888888730564116E-3;
+    constexpr double C5 = 4.16666666666665929218E-2;
+
+#ifdef VECTORMATH_X86
+    __attribute__((target("avx2"))) size_t vectorSinAVX2(const double *in, double *out, size_t count)
+    {
+        const __m256d signMask = _mm256_set1_pd(-0.0);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m256d x = _mm256_loadu_pd(in + i);
+            __m256d sign = _mm256_and_pd(x, signMask);
+            __m256d y = _mm256_andnot_pd(signMask, x);
+
+            // Octant, rounded up to even
+            __m128i j = _mm256_cvttpd_epi32(_mm256_mul_pd(y, _mm256_set1_pd(fourOverPi)));
+            j = _mm_and_si128(_mm_add_epi32(j, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+            __m256d yf = _mm256_cvtepi32_pd(j);
+
+            y = _mm256_sub_pd(y, _mm256_mul_pd(yf, _mm256_set1_pd(DP1)));
+            y = _mm256_sub_pd(y, _mm256_mul_pd(yf, _mm256_set1_pd(DP2)));
+            y = _mm256_sub_pd(y, _mm256_mul_pd(yf, _mm256_set1_pd(DP3)));
+
+            __m256i j64 = _mm256_cvtepi32_epi64(j);
+            __m256d flip = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_and_si256(j64, _mm256_set1_epi64x(4)), 61));
+            __m256d useCos = _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(j64, _mm256_set1_epi64x(2)), _mm256_set1_epi64x(2)));
+
+            __m256d z = _mm256_mul_pd(y, y);
+
+            __m256d s = _mm256_set1_pd(S0);
+            s = _mm256_add_pd(_mm256_mul_pd(s, z), _mm256_set1_pd(S1));
+            s = _mm256_add_pd(_mm256_mul_pd(s, z), _mm256_set1_pd(S2));
+            s = _mm256_add_pd(_mm256_mul_pd(s, z), _mm256_set1_pd(S3));
+            s = _mm256_add_pd(_mm256_mul_pd(s, z), _mm256_set1_pd(S4));
+            s = _mm256_add_pd(_mm256_mul_pd(s, z), _mm256_set1_pd(S5));
+            s = _mm256_add_pd(y, _mm256_mul_pd(_mm256_mul_pd(y, z), s));
+
+            __m256d c = _mm256_set1_pd(C0);
+            c = _mm256_add_pd(_mm256_mul_pd(c, z), _mm256_set1_pd(C1));
+            c = _mm256_add_pd(_mm256_mul_pd(c, z), _mm256_set1_pd(C2));
+            c = _mm256_add_pd(_mm256_mul_pd(c, z), _mm256_set1_pd(C3));
+            c = _mm256_add_pd(_mm256_mul_pd(c, z), _mm256_set1_pd(C4));
+            c = _mm256_add_pd(_mm256_mul_pd(c, z), _mm256_set1_pd(C5));
+            c = _mm256_add_pd(_mm256_sub_pd(_mm256_set1_pd(1.0), _mm256_mul_pd(_mm256_set1_pd(0.5), z)),
+                              _mm256_mul_pd(_mm256_mul_pd(z, z), c));
+
+            __m256d result = _mm256_blendv_pd(s, c, useCos);
+            result = _mm256_xor_pd(result, _mm256_xor_pd(sign, flip));
+
+            // Ordered compare: false for NaN as well as for huge or infinite arguments
+            __m256d inRange = _mm256_cmp_pd(_mm256_andnot_pd(signMask, x), _mm256_set1_pd(reductionLimit), _CMP_LE_OQ);
+            int inRangeMask = _mm256_movemask_pd(inRange);
+            if (inRangeMask == 0xF)
+            {
+                _mm256_storeu_pd(out + i, result);
+            }
+            else
+            {
+                // Rare: read the inputs before storing, since `in` may alias `out`
+                alignas(32) double lanes[4], args[4];
+                _mm256_store_pd(lanes, result);
+                _mm256_store_pd(args, x);
+                for (int lane = 0; lane < 4; ++lane)
+                    out[i + lane] = (inRangeMask >> lane) & 1 ? lanes[lane] : std::sin(args[lane]);
+            }
+        }
+        return i;
+    }
+#endif
+}
+
+double polySin(double x)
+{
+    double sign = std::copysign(1.0, x);
+    double y = std::fabs(x);
+
+    // Also catches NaN, for which every comparison is false
+    if (!(y <= reductionLimit))
+        return std::sin(x);
+
+    int32_t j = static_cast<int32_t>(y * fourOverPi);
+    j = (j + 1) & ~1;
+    double yf = static_cast<double>(j);
+
+    y = y - yf * DP1;
+    y = y - yf * DP2;
+    y = y - yf * DP3;
+
+    if (j & 4)
+        sign = -sign;
+
+    double z = y * y;
+    double result;
+    if (j & 2)
+    {
+        double c = C0;
+        c = c * z + C1;
+        c = c * z + C2;
+        c = c * z + C3;
+        c = c * z + C4;
+        c = c * z + C5;
+        result = (1.0 - 0.5 * z) + (z * z) * c;
+    }
+    else
+    {
+        double s = S0;
+        s = s * z + S1;
+        s = s * z + S2;
+        s = s * z + S3;
+        s = s * z + S4;
+        s = s * z + S5;
+        result = y + (y * z) * s;
+    }
+    return sign * result;
+}
+
+void vectorSin(const double *in, double *out, size_t count)
+{
+    size_t i = 0;
+#ifdef VECTORMATH_X86
+    if (__builtin_cpu_supports("avx2"))
+        i = vectorSinAVX2(in, out, count);
+#endif
+    for (; i < count; ++i)
+        out[i] = polySin(in[i]);
+}
@@ -1,15 +1,19 @@
 #include "VelocitySystem.h"
 
 VelocitySystem::VelocitySystem(double time_step)
-    : velocity_(0.0), time_step_(time_step) {}
+    : system_(time_step) {}
 
 double VelocitySystem::update(double controlSignal)
 {
-    velocity_ += controlSignal * time_step_;
-    return velocity_;
+    return system_.update(controlSignal);
+}
+
+double VelocitySystem::advance(double controlSignal, long long nSteps)
+{
+    return system_.advance(controlSignal, nSteps);
 }
 
 double VelocitySystem::getOutput() const
 {
-    return velocity_;
+    return system_.getOutput();
 }
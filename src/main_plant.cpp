@@ -1,63 +1,61 @@
-#include "IPID.h"
-#include "PID.h"
+#include "BasicPID.h"
 #include "PositionSystem.h"
 #include "TemperatureSystem.h"
 #include "VelocitySystem.h"
 #include "InvertedPendulumSystem.h"
+#include "Simulation.h"
+#include "Telemetry.h"
 #include <iostream>
-#include <memory>
-#include <chrono>
-#include <thread>
+#include <string>
 
-void simulate(IPlant &system, IPID &pid, double setpoint, int steps)
-{
-    // Define simulation parameters
-    const double controlToVelocityGain = 1.0; // maps control signal to velocity change
-    const double samplingPeriod = 0.05;       // time step in seconds
-
-    for (int i = 0; i < steps; ++i)
-    {
-        double output = system.getOutput();
-        double error = setpoint - output;
-        double controlSignal = pid.control(error);
-
-        // Simulate plant dynamics based on control signal
-        double response = system.update(controlSignal * controlToVelocityGain);
-
-        std::cout << "Step " << i
-                  << " | Setpoint: " << setpoint
-                  << " | Output: " << output
-                  << " | Error: " << error
-                  << " | Control: " << controlSignal
-                  << " | Response: " << response << std::endl;
-
-        std::this_thread::sleep_for(std::chrono::duration<double>(samplingPeriod));
-    }
-}
-
-int main()
+// Usage: main_plant [telemetry-prefix]
+// Without arguments every step is printed. With a prefix, each run is logged
+// to <prefix>_<system>.bin in the background and exported to <prefix>_<system>.csv.
+int main(int argc, char *argv[])
 {
     const int steps = 100;
     double setpoint = 1.0;
+    const std::string telemetryPrefix = argc > 1 ? argv[1] : "";
 
-    PID standardPid(1.0, 0.1, 0.05);
-
+    auto run = [&](const char *name, auto &system, auto &pid, double target)
+    {
+        if (telemetryPrefix.empty())
+        {
+            simulate(system, pid, target, steps);
+            return;
+        }
+
+        std::string base = telemetryPrefix + "_" + name;
+        TelemetryLogger logger(base + ".bin");
+        simulate(system, pid, target, steps, Pacing::realtime(0.05), logger);
+        logger.close();
+        if (logger.writeFailed())
+            std::cerr << "Writing " << base << ".bin failed; the log is incomplete\n";
+        exportTelemetryCsv(base + ".bin", base + ".csv");
+        std::cout << "Logged " << logger.written() << " steps to " << base << ".bin ("
+                  << logger.dropped() << " dropped)\n";
+    };
+
+    // Every run gets its own controller so no integrator state leaks between them
     std::cout << "\n--- Simulating Position System ---\n";
     PositionSystem posSystem;
-    simulate(posSystem, standardPid, setpoint, steps);
+    BasicPID<double> positionPid(1.0, 0.1, 0.05);
+    run("position", posSystem, positionPid, setpoint);
 
     std::cout << "\n--- Simulating Velocity System ---\n";
     VelocitySystem velSystem;
-    simulate(velSystem, standardPid, setpoint, steps);
+    BasicPID<double> velocityPid(1.0, 0.1, 0.05);
+    run("velocity", velSystem, velocityPid, setpoint);
 
     std::cout << "\n--- Simulating Temperature System ---\n";
     TemperatureSystem tempSystem;
-    simulate(tempSystem, standardPid, 100.0, steps); // Adjusted setpoint
+    BasicPID<double> temperaturePid(1.0, 0.1, 0.05);
+    run("temperature", tempSystem, temperaturePid, 100.0); // Adjusted setpoint
 
     std::cout << "\n--- Simulating Inverted Pendulum ---\n";
     InvertedPendulumSystem pendulum;
-    PID pendulumPid(30.0, 1.0, 5.0);             // More aggressive
-    simulate(pendulum, pendulumPid, 0.0, steps); // Target is upright
+    BasicPID<double> pendulumPid(30.0, 1.0, 5.0); // More aggressive
+    run("pendulum", pendulum, pendulumPid, 0.0); // Target is upright
 
     return 0;
-}
\ No newline at end of file
+}
@@ -4,34 +4,151 @@
 #include "TemperatureSystem.h"
 #include "VelocitySystem.h"
 #include "InvertedPendulumSystem.h"
+#include "Pacing.h"
+#include "PlotBuffer.h"
+#include "Simulation.h"
+#include "SpscRing.h"
 #include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <atomic>
 #include <iostream>
-#include <memory>
-#include <chrono>
-#include <thread>
-
-#include <SFML/Graphics.hpp>
-#include <vector>
 #include <string>
-#include <chrono>
 #include <thread>
+#include <vector>
 
-void simulateVisual(IPlant &system, IPID &pid, double setpoint, int steps, const std::string &title)
+/// @class PlotTrace
+/// @brief One line of the plot, kept in data units (x: step, y: value).
+///
+/// Samples are min/max decimated to at most two points per pixel column, so
+/// the vertex count is bounded by the window width however long the run.
+/// New points are uploaded to the vertex buffer incrementally; scaling to the
+/// window is left to the render transform, so rescaling rebuilds nothing.
+class PlotTrace
 {
-    const double controlToVelocityGain = 1.0;
-    const double samplingPeriod = 0.05;
+public:
+    PlotTrace(size_t capacity, double columnWidth, sf::Color color)
+        : m_ring(capacity), m_decimator(columnWidth), m_vertices(capacity),
+          m_buffer(sf::LineStrip, sf::VertexBuffer::Stream), m_color(color)
+    {
+        m_useBuffer = sf::VertexBuffer::isAvailable() && m_buffer.create(capacity);
+    }
+
+    void add(double x, double y)
+    {
+        PlotPoint points[2];
+        size_t count = m_decimator.add(x, y, points);
+        for (size_t i = 0; i < count; ++i)
+            m_ring.push(points[i]);
+    }
 
-    std::vector<double> outputs;
-    std::vector<double> setpoints;
+    /// @brief Emits the column still held by the decimator; call once the run is over.
+    void flush()
+    {
+        PlotPoint points[2];
+        size_t count = m_decimator.flush(points);
+        for (size_t i = 0; i < count; ++i)
+            m_ring.push(points[i]);
+    }
+
+    void draw(sf::RenderTarget &target, const sf::RenderStates &states)
+    {
+        // Only the points added since the last frame are copied
+        m_ring.takeDirty([&](size_t first, size_t count)
+                         {
+            for (size_t i = first; i < first + count; ++i)
+                m_vertices[i] = sf::Vertex(sf::Vector2f(m_ring.data()[i].x, m_ring.data()[i].y), m_color);
+            if (m_useBuffer)
+                m_buffer.update(&m_vertices[first], count, static_cast<unsigned>(first)); });
+
+        // Oldest first: from head() to the end of storage, then from slot 0
+        size_t head = m_ring.head();
+        size_t size = m_ring.size();
+        size_t tail = std::min(size, m_ring.capacity() - head);
+        drawRange(target, head, tail, states);
+        if (size > tail)
+            drawRange(target, 0, size - tail, states);
+    }
+
+private:
+    void drawRange(sf::RenderTarget &target, size_t first, size_t count, const sf::RenderStates &states)
+    {
+        if (count < 2)
+            return;
+        if (m_useBuffer)
+            target.draw(m_buffer, first, count, states);
+        else
+            target.draw(&m_vertices[first], count, sf::LineStrip, states);
+    }
 
+    PlotRing m_ring;
+    MinMaxDecimator m_decimator;
+    std::vector<sf::Vertex> m_vertices;
+    sf::VertexBuffer m_buffer;
+    sf::Color m_color;
+    bool m_useBuffer = false;
+};
+
+/// @brief Runs the closed loop on its own thread and plots it at display rate.
+///
+/// The simulation thread publishes every StepSample through a lock-free SPSC
+/// ring and never waits on the window; the render thread drains whatever has
+/// arrived once per frame, so with a fast pacing thousands of steps may land
+/// in one frame while events are still handled promptly. Closing the window,
+/// or an exception, stops the simulation thread, which is joined before returning.
+void simulateVisual(IPlant &system, IPID &pid, double setpoint, int steps, const std::string &title,
+                    const Pacing &pacing = Pacing::realtime(0.05))
+{
     const int windowWidth = 800;
     const int windowHeight = 600;
     sf::RenderWindow window(sf::VideoMode(windowWidth, windowHeight), title);
+    window.setFramerateLimit(60);
+
+    // One column per pixel, two points per column: the run always fits
+    const double columnWidth = static_cast<double>(steps) / windowWidth;
+    const size_t capacity = 2 * windowWidth + 2;
+    PlotTrace outputTrace(capacity, columnWidth, sf::Color::Yellow);
+    PlotTrace setpointTrace(capacity, columnWidth, sf::Color::Red);
 
     double yMin = setpoint - 1.0;
     double yMax = setpoint + 1.0;
 
-    for (int step = 0; step < steps && window.isOpen(); ++step)
+    SpscRing<StepSample> samples(1 << 16);
+    std::atomic<bool> stop{false};
+    std::atomic<bool> finished{false};
+
+    std::thread simulation([&]()
+                           {
+        Pacer pacer(pacing);
+        for (int step = 0; step < steps && !stop.load(std::memory_order_relaxed); ++step)
+        {
+            StepSample sample = closedLoopStep(system, pid, setpoint, step);
+
+            // A full ring means the renderer is behind: wait rather than lose samples
+            while (!samples.tryPush(sample))
+            {
+                if (stop.load(std::memory_order_relaxed))
+                    return;
+                std::this_thread::yield();
+            }
+            pacer.waitForNextStep();
+        }
+        finished.store(true, std::memory_order_release); });
+
+    // Stops and joins the simulation thread however this function is left, so an
+    // exception from the render loop never destroys a joinable thread
+    struct JoinGuard
+    {
+        std::atomic<bool> &stop;
+        std::thread &thread;
+        ~JoinGuard()
+        {
+            stop.store(true, std::memory_order_relaxed);
+            thread.join();
+        }
+    } joinGuard{stop, simulation};
+
+    std::vector<StepSample> batch(4096);
+    while (window.isOpen())
     {
         sf::Event event;
         while (window.pollEvent(event))
@@ -40,46 +157,47 @@ void simulateVisual(IPlant &system, IPID &pid, double setpoint, int steps, const
                 window.close();
         }
 
-        double output = system.getOutput();
-        double error = setpoint - output;
-        double controlSignal = pid.control(error);
-        system.update(controlSignal * controlToVelocityGain);
-
-        outputs.push_back(output);
-        setpoints.push_back(setpoint);
-
-        if (output < yMin)
-            yMin = output - 0.1;
-        if (output > yMax)
-            yMax = output + 0.1;
-
-        window.clear(sf::Color::Black);
-
-        // Draw output (yellow)
-        sf::VertexArray outputLine(sf::LineStrip, outputs.size());
-        for (size_t i = 0; i < outputs.size(); ++i)
+        // Read the flag first: once it is set, everything it covers is already queued
+        bool done = finished.load(std::memory_order_acquire);
+        size_t count;
+        while ((count = samples.popBatch(batch.data(), batch.size())) > 0)
         {
-            float x = static_cast<float>(i) / steps * windowWidth;
-            float y = static_cast<float>(windowHeight - ((outputs[i] - yMin) / (yMax - yMin)) * windowHeight);
-            outputLine[i].position = sf::Vector2f(x, y);
-            outputLine[i].color = sf::Color::Yellow;
+            for (size_t i = 0; i < count; ++i)
+            {
+                const StepSample &s = batch[i];
+                outputTrace.add(static_cast<double>(s.step), s.output);
+                setpointTrace.add(static_cast<double>(s.step), s.setpoint);
+
+                if (s.output < yMin)
+                    yMin = s.output - 0.1;
+                if (s.output > yMax)
+                    yMax = s.output + 0.1;
+            }
         }
+        if (!window.isOpen())
+            break;
 
-        // Draw setpoint (red)
-        sf::VertexArray setpointLine(sf::LineStrip, setpoints.size());
-        for (size_t i = 0; i < setpoints.size(); ++i)
+        // Nothing more is coming: the last, partly filled column goes into the final frame
+        if (done)
         {
-            float x = static_cast<float>(i) / steps * windowWidth;
-            float y = static_cast<float>(windowHeight - ((setpoints[i] - yMin) / (yMax - yMin)) * windowHeight);
-            setpointLine[i].position = sf::Vector2f(x, y);
-            setpointLine[i].color = sf::Color::Red;
+            outputTrace.flush();
+            setpointTrace.flush();
         }
 
-        window.draw(setpointLine);
-        window.draw(outputLine);
+        // Data units to pixels, with y pointing up
+        sf::Transform toScreen;
+        toScreen.translate(0.0f, static_cast<float>(windowHeight));
+        toScreen.scale(static_cast<float>(windowWidth) / steps, static_cast<float>(-windowHeight / (yMax - yMin)));
+        toScreen.translate(0.0f, static_cast<float>(-yMin));
+        sf::RenderStates states(toScreen);
+
+        window.clear(sf::Color::Black);
+        setpointTrace.draw(window, states);
+        outputTrace.draw(window, states);
         window.display();
 
-        std::this_thread::sleep_for(std::chrono::duration<double>(samplingPeriod));
+        if (done)
+            break;
     }
 }
 
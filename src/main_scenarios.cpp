@@ -0,0 +1,37 @@
+#include "ScenarioRunner.h"
+#include "Simulation.h"
+#include <chrono>
+#include <iostream>
+
+// Usage: main_scenarios [config] (defaults to scenarios.cfg)
+int main(int argc, char *argv[])
+{
+    const std::string path = argc > 1 ? argv[1] : "scenarios.cfg";
+
+    std::vector<Scenario> scenarios;
+    std::string error;
+    if (!loadScenarios(path, scenarios, error))
+    {
+        std::cerr << path << ": " << error << "\n";
+        return 1;
+    }
+
+    ThreadPool pool;
+    ScenarioRunner runner(pool);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<ScenarioResult> results = runner.runAll(scenarios);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    ConsoleObserver print;
+    for (const ScenarioResult &result : results)
+    {
+        std::cout << "\n--- " << result.name << " ---\n";
+        for (const StepSample &sample : result.samples)
+            print(sample);
+    }
+
+    std::cout << "\nRan " << results.size() << " scenarios on " << pool.size()
+              << " threads in " << elapsed.count() << " s\n";
+    return 0;
+}
@@ -0,0 +1,54 @@
+#include "MonteCarloSweep.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace
+{
+    void printSummary(const std::string &name, const MetricSummary &summary)
+    {
+        const Histogram &h = summary.histogram();
+        std::cout << name
+                  << " | mean: " << summary.mean()
+                  << " | stddev: " << summary.stddev()
+                  << " | min: " << summary.min()
+                  << " | p5: " << h.quantile(0.05)
+                  << " | p50: " << h.quantile(0.5)
+                  << " | p95: " << h.quantile(0.95)
+                  << " | max: " << summary.max() << "\n";
+    }
+}
+
+// Usage: main_sweep [trials] [seed]
+// Robustness of PID(1.0, 0.1, 0.05) on the pendulum under varied time step,
+// length, inertia and initial angle.
+int main(int argc, char *argv[])
+{
+    SweepProblem problem;
+    problem.space.timeStep = Distribution::uniform(0.005, 0.02);
+    problem.space.length = Distribution::uniform(0.8, 1.2);
+    problem.space.inertia = Distribution::uniform(0.8, 1.2);
+    problem.space.initialAngle = Distribution::uniform(-0.3, 0.3);
+
+    SweepOptions options;
+    options.trials = argc > 1 ? std::atoll(argv[1]) : 1000000;
+    options.seed = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1;
+    options.iaeHistogram = Histogram(0.0, 40.0, 400);
+    options.overshootHistogram = Histogram(0.0, 200.0, 400);
+    options.finalErrorHistogram = Histogram(0.0, 50.0, 500);
+
+    ThreadPool pool;
+    MonteCarloSweep sweep(problem, pool);
+
+    auto start = std::chrono::steady_clock::now();
+    SweepResult result = sweep.run(options);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << result.trials << " trials on " << pool.size() << " threads in " << elapsed.count() << " s, "
+              << result.unstable << " unstable\n";
+    printSummary("IAE", result.iae);
+    printSummary("Overshoot", result.overshoot);
+    printSummary("Final |error|", result.finalError);
+    return 0;
+}
@@ -0,0 +1,51 @@
+#include "PIDAutoTuner.h"
+#include "PositionSystem.h"
+#include "TemperatureSystem.h"
+#include "VelocitySystem.h"
+#include "InvertedPendulumSystem.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+
+template <typename Plant>
+void tunePlant(const std::string &name, ThreadPool &pool, double setpoint, double sampleTime, double relayAmplitude)
+{
+    TuningProblem problem;
+    problem.makePlant = []()
+    { return std::make_unique<Plant>(); };
+    problem.setpoint = setpoint;
+    problem.steps = 200;
+    problem.sampleTime = sampleTime;
+
+    CostWeights weights;
+    weights.itae = 0.1;
+    weights.overshoot = 1.0;
+
+    auto start = std::chrono::steady_clock::now();
+    PIDAutoTuner tuner(problem, pool, weights);
+    TuningResult result = tuner.tune(relayAmplitude);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << name
+              << " | Kp: " << result.gains.Kp
+              << " | Ki: " << result.gains.Ki
+              << " | Kd: " << result.gains.Kd
+              << " | IAE: " << result.score.iae
+              << " | ITAE: " << result.score.itae
+              << " | Overshoot: " << result.score.overshoot * 100.0 << "%"
+              << " | Evaluations: " << result.evaluations
+              << " | Time: " << elapsed.count() << " s\n";
+}
+
+int main()
+{
+    ThreadPool pool;
+    std::cout << "Tuning on " << pool.size() << " threads\n";
+
+    tunePlant<PositionSystem>("Position System", pool, 1.0, 0.1, 1.0);
+    tunePlant<VelocitySystem>("Velocity System", pool, 1.0, 0.1, 1.0);
+    tunePlant<TemperatureSystem>("Temperature System", pool, 100.0, 0.1, 10.0);
+    tunePlant<InvertedPendulumSystem>("Inverted Pendulum", pool, 0.0, 0.01, 20.0);
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <type_traits>
+#include "BasicPID.h"
+#include "PID.h"
+
+namespace
+{
+    struct PendulumGains
+    {
+        static constexpr double Kp = 30.0;
+        static constexpr double Ki = 1.0;
+        static constexpr double Kd = 5.0;
+    };
+}
+
+TEST(BasicPIDTest, DefaultPolicyMatchesPID)
+{
+    PID reference(30.0, 1.0, 5.0);
+    BasicPID<double> pid(30.0, 1.0, 5.0);
+    reference.setAntiWindupGain(0.3);
+    pid.setAntiWindupGain(0.3);
+
+    // Large errors drive the output into the clamp, so anti-windup is exercised too
+    for (int i = 0; i < 100; ++i)
+    {
+        double error = 5.0 * ((i % 7) - 3);
+        EXPECT_EQ(pid.control(error), reference.control(error));
+    }
+}
+
+TEST(BasicPIDTest, FixedGainsBehaveLikeRuntimeGains)
+{
+    using FixedPolicy = PIDPolicy<pid_policy::ClampOutput, pid_policy::PartialIntegration,
+                                  pid_policy::DerivativeOnError, pid_policy::FixedGains<PendulumGains>>;
+    BasicPID<double, FixedPolicy> fixed;
+    BasicPID<double> runtime(30.0, 1.0, 5.0);
+
+    static_assert(pid_policy::GainStorage<double, pid_policy::FixedGains<PendulumGains>>::Kp() == 30.0,
+                  "fixed gains are compile-time constants");
+    EXPECT_EQ(fixed.Kd(), 5.0);
+
+    for (int i = 0; i < 20; ++i)
+    {
+        double error = 0.1 * i - 1.0;
+        EXPECT_EQ(fixed.control(error), runtime.control(error));
+    }
+}
+
+TEST(BasicPIDTest, NoClampPassesLargeOutputs)
+{
+    BasicPID<double, PIDPolicy<pid_policy::NoClamp>> pid(100.0, 0.0, 0.0);
+    EXPECT_DOUBLE_EQ(pid.control(5.0), 500.0);
+}
+
+TEST(BasicPIDTest, ConditionalIntegrationFreezesIntegrator)
+{
+    BasicPID<double, PIDPolicy<pid_policy::ClampOutput, pid_policy::ConditionalIntegration>> pid(0.0, 1.0, 0.0);
+    pid.setOutputLimits(-1.0, 1.0);
+
+    EXPECT_DOUBLE_EQ(pid.control(0.5), 0.5);
+    EXPECT_DOUBLE_EQ(pid.control(5.0), 1.0);  // saturated, integrator stays at 0.5
+    EXPECT_DOUBLE_EQ(pid.control(-0.5), 0.0); // 0.5 - 0.5
+}
+
+TEST(BasicPIDTest, NoDerivativeIgnoresKd)
+{
+    BasicPID<double, PIDPolicy<pid_policy::ClampOutput, pid_policy::PartialIntegration, pid_policy::NoDerivative>> pid(1.0, 0.0, 10.0);
+    pid.control(1.0);
+    EXPECT_DOUBLE_EQ(pid.control(3.0), 3.0);
+}
+
+TEST(BasicPIDTest, ControlIsNotVirtual)
+{
+    EXPECT_FALSE(std::is_polymorphic<BasicPID<double>>::value);
+}
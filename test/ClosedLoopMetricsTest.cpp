@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cmath>
+#include <sstream>
+#include <vector>
+#include "BasicPID.h"
+#include "ClosedLoopMetrics.h"
+#include "Simulation.h"
+#include "VelocitySystem.h"
+
+namespace
+{
+    // A first-order response 1 - exp(-t/tau) sampled every dt, driven by a constant control
+    std::vector<StepSample> firstOrderStep(double tau, double dt, int steps)
+    {
+        std::vector<StepSample> samples;
+        for (int k = 0; k < steps; ++k)
+        {
+            double output = 1.0 - std::exp(-k * dt / tau);
+            double next = 1.0 - std::exp(-(k + 1) * dt / tau);
+            samples.push_back({k, 1.0, output, 1.0 - output, 2.0, next});
+        }
+        return samples;
+    }
+}
+
+TEST(ClosedLoopMetricsTest, FirstOrderStepResponse)
+{
+    const double tau = 1.0, dt = 0.001;
+    ClosedLoopMetrics metrics(dt);
+    for (const StepSample &s : firstOrderStep(tau, dt, 10000))
+        metrics(s);
+
+    // Analytic values: 10-90 % rise time tau ln 9, 2 % settling time tau ln 50
+    ASSERT_TRUE(metrics.riseTime());
+    EXPECT_NEAR(*metrics.riseTime(), tau * std::log(9.0), 2 * dt);
+    ASSERT_TRUE(metrics.settlingTime());
+    EXPECT_NEAR(*metrics.settlingTime(), tau * std::log(50.0), 2 * dt);
+    EXPECT_EQ(metrics.overshoot(), 0.0);
+
+    // Integrals: IAE = tau, ISE = tau / 2, ITAE = tau^2 (over an effectively infinite horizon)
+    EXPECT_NEAR(metrics.iae(), tau, 1e-3);
+    EXPECT_NEAR(metrics.ise(), tau / 2, 1e-3);
+    EXPECT_NEAR(metrics.itae(), tau * tau, 1e-3);
+
+    EXPECT_NEAR(metrics.controlEnergy(), 4.0 * 10000 * dt, 1e-9);
+    EXPECT_EQ(metrics.controlVariation(), 0.0);
+    EXPECT_GT(metrics.steadyStateError(), 0.0);
+    EXPECT_LT(metrics.steadyStateError(), 0.02);
+    EXPECT_EQ(metrics.samples(), 10000);
+}
+
+TEST(ClosedLoopMetricsTest, OvershootAndUnsettledResponse)
+{
+    ClosedLoopMetrics metrics(0.1);
+    // Output 0 -> 1.5 -> 0.5 against setpoint 1
+    metrics({0, 1.0, 0.0, 1.0, 1.0, 1.5});
+    metrics({1, 1.0, 1.5, -0.5, -1.0, 0.5});
+    metrics({2, 1.0, 0.5, 0.5, 3.0, 0.9});
+
+    EXPECT_DOUBLE_EQ(metrics.overshoot(), 0.5);
+    ASSERT_TRUE(metrics.riseTime());
+    EXPECT_DOUBLE_EQ(*metrics.riseTime(), 0.0); // both thresholds crossed on the same sample
+    EXPECT_FALSE(metrics.settlingTime());
+    EXPECT_EQ(metrics.steadyStateError(), 0.5);
+    EXPECT_DOUBLE_EQ(metrics.controlVariation(), 2.0 + 4.0);
+}
+
+TEST(ClosedLoopMetricsTest, LeavingTheBandRestartsSettling)
+{
+    ClosedLoopMetrics metrics(1.0);
+    metrics({0, 1.0, 0.0, 1.0, 0.0, 0.0});
+    metrics({1, 1.0, 0.99, 0.01, 0.0, 0.0});
+    EXPECT_EQ(metrics.settlingTime(), 1.0);
+    metrics({2, 1.0, 1.1, -0.1, 0.0, 0.0});
+    EXPECT_FALSE(metrics.settlingTime());
+    metrics({3, 1.0, 1.01, -0.01, 0.0, 0.0});
+    metrics({4, 1.0, 1.00, 0.0, 0.0, 0.0});
+    EXPECT_EQ(metrics.settlingTime(), 3.0);
+    EXPECT_DOUBLE_EQ(metrics.steadyStateError(), -0.005);
+
+    metrics.reset();
+    EXPECT_EQ(metrics.samples(), 0);
+    EXPECT_EQ(metrics.iae(), 0.0);
+}
+
+TEST(ClosedLoopMetricsTest, PlugsIntoSimulateAlongsideOtherObservers)
+{
+    VelocitySystem plant;
+    BasicPID<double> pid(1.0, 0.1, 0.05);
+    ClosedLoopMetrics metrics(0.1);
+    std::ostringstream log;
+    ConsoleObserver console{log};
+
+    simulate(plant, pid, 1.0, 200, Pacing::unthrottled(0.1), observeAll(metrics, console));
+
+    EXPECT_EQ(metrics.samples(), 200);
+    EXPECT_TRUE(metrics.riseTime());
+    EXPECT_TRUE(metrics.settlingTime());
+    EXPECT_NEAR(metrics.steadyStateError(), 0.0, 0.02);
+    EXPECT_THAT(log.str(), ::testing::HasSubstr("Step 199 |"));
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <string>
+#include <vector>
+#include "CoSimulation.h"
+#include "InvertedPendulumSystem.h"
+#include "PID.h"
+#include "PositionSystem.h"
+#include "Simulation.h"
+
+TEST(EventSchedulerTest, RunsByTimeThenPriorityThenInsertionOrder)
+{
+    EventScheduler scheduler;
+    std::string order;
+    scheduler.schedule(20, [&]
+                       { order += "c"; });
+    scheduler.schedule(10, [&]
+                       { order += "b"; }, 1);
+    scheduler.schedule(10, [&]
+                       { order += "a"; }, 0);
+    scheduler.schedule(10, [&]
+                       { order += "B"; }, 1);
+    scheduler.schedule(30, [&]
+                       { order += "x"; });
+
+    scheduler.runUntil(30);
+    EXPECT_EQ(order, "abBc");
+    EXPECT_EQ(scheduler.now(), 30);
+    EXPECT_EQ(scheduler.pending(), 1u);
+
+    scheduler.runUntil(31);
+    EXPECT_EQ(order, "abBcx");
+    EXPECT_EQ(scheduler.executed(), 5);
+}
+
+TEST(EventSchedulerTest, PeriodicTasksKeepAnExactIntegerSchedule)
+{
+    EventScheduler scheduler;
+    std::vector<SimTime> times;
+    scheduler.every(0, fromSeconds(0.1), [&]
+                    { times.push_back(scheduler.now()); });
+
+    scheduler.runUntil(fromSeconds(1000.0));
+    ASSERT_EQ(times.size(), 10000u);
+    EXPECT_EQ(times.back(), fromSeconds(999.9)); // 0.1 s added 9999 times without drift
+
+    // Tasks can schedule more work, which runs in the same pass when it is due
+    int followUps = 0;
+    scheduler.schedule(scheduler.now(), [&]
+                       { scheduler.schedule(scheduler.now() + 5, [&]
+                                            { ++followUps; }); });
+    scheduler.runUntil(scheduler.now() + 10);
+    EXPECT_EQ(followUps, 1);
+}
+
+TEST(CoSimulationTest, SingleRateZeroLatencyMatchesSimulate)
+{
+    PositionSystem coPlant, plant;
+    PID coPid(1.0, 0.1, 0.05), pid(1.0, 0.1, 0.05);
+
+    std::vector<StepSample> coSamples, samples;
+    CoSimulation cosim;
+    cosim.addLoop(coPlant, coPid, 1.0, {fromSeconds(0.1), fromSeconds(0.1)}, [&](const StepSample &s)
+                  { coSamples.push_back(s); });
+    cosim.run(fromSeconds(10.0));
+
+    simulate(plant, pid, 1.0, 100, Pacing::unthrottled(0.1), [&](const StepSample &s)
+             { samples.push_back(s); });
+
+    ASSERT_EQ(coSamples.size(), samples.size());
+    for (size_t i = 0; i < samples.size(); ++i)
+    {
+        EXPECT_EQ(coSamples[i].output, samples[i].output) << i;
+        EXPECT_EQ(coSamples[i].control, samples[i].control) << i;
+    }
+    EXPECT_EQ(coPlant.getOutput(), plant.getOutput());
+    EXPECT_EQ(cosim.stats(0).plantSteps, 100);
+    EXPECT_EQ(cosim.stats(0).controlSamples, 100);
+    EXPECT_EQ(cosim.stats(0).actuations, 100);
+}
+
+TEST(CoSimulationTest, FastPlantSlowControllerRunsEachAtItsOwnRate)
+{
+    InvertedPendulumSystem plant(0.001);
+    PID pid(30.0, 1.0, 5.0);
+    CoSimulation cosim;
+    size_t loop = cosim.addLoop(plant, pid, 0.0, {fromSeconds(0.001), fromSeconds(0.02)});
+
+    cosim.run(fromSeconds(2.0));
+    EXPECT_EQ(cosim.stats(loop).plantSteps, 2000);
+    EXPECT_EQ(cosim.stats(loop).controlSamples, 100);
+    EXPECT_EQ(cosim.now(), fromSeconds(2.0));
+}
+
+TEST(CoSimulationTest, LatencyDelaysTheMeasurementAndTheActuation)
+{
+    PositionSystem plant(0.01);
+    PID pid(1.0, 0.0, 0.0);
+    std::vector<SimTime> computeTimes;
+    CoSimulation cosim;
+    LoopTiming timing{fromSeconds(0.01), fromSeconds(0.1), fromSeconds(0.02), fromSeconds(0.03)};
+    cosim.addLoop(plant, pid, 1.0, timing, [&](const StepSample &)
+                  { computeTimes.push_back(cosim.now()); });
+
+    // Before the first actuation lands at 0.05 s the plant sees no input
+    cosim.run(fromSeconds(0.05));
+    EXPECT_EQ(plant.getOutput(), 0.0);
+    EXPECT_EQ(cosim.stats(0).actuations, 0);
+    ASSERT_EQ(computeTimes.size(), 1u);
+    EXPECT_EQ(computeTimes[0], fromSeconds(0.02));
+
+    cosim.run(fromSeconds(0.01));
+    EXPECT_EQ(cosim.stats(0).actuations, 1);
+    EXPECT_GT(plant.getOutput(), 0.0);
+}
+
+TEST(CoSimulationTest, LoopsAreIndependent)
+{
+    PositionSystem a, b;
+    PID pidA(1.0, 0.1, 0.05), pidB(1.0, 0.1, 0.05);
+    CoSimulation cosim;
+    cosim.addLoop(a, pidA, 1.0, {fromSeconds(0.1), fromSeconds(0.1)});
+    cosim.addLoop(b, pidB, 1.0, {fromSeconds(0.1), fromSeconds(0.1), fromSeconds(0.1)});
+    cosim.run(fromSeconds(3.0));
+    EXPECT_NE(a.getOutput(), b.getOutput());
+    EXPECT_EQ(cosim.stats(0).plantSteps, cosim.stats(1).plantSteps);
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cmath>
+#include "FixedPoint.h"
+#include "BasicPID.h"
+#include "InvertedPendulumSystem.h"
+#include "PositionSystem.h"
+#include "TemperatureSystem.h"
+#include "VelocitySystem.h"
+
+TEST(FixedPointTest, RoundTripsThroughDouble)
+{
+    EXPECT_DOUBLE_EQ(static_cast<double>(Q16_16(1.5)), 1.5);
+    EXPECT_DOUBLE_EQ(static_cast<double>(Q16_16(-2.25)), -2.25);
+    EXPECT_NEAR(static_cast<double>(Q32_32(0.1)), 0.1, Q32_32::resolution());
+    EXPECT_EQ(Q16_16(3).raw(), 3 << 16);
+
+    // Negative integers are scaled by multiplication, so this is a constant expression
+    static_assert(Q16_16(-3).raw() == -3 * 65536, "negative integer construction");
+    EXPECT_DOUBLE_EQ(static_cast<double>(Q16_16(-3)), -3.0);
+}
+
+TEST(FixedPointTest, ArithmeticRoundsToNearest)
+{
+    EXPECT_DOUBLE_EQ(static_cast<double>(Q16_16(1.5) + Q16_16(2.25)), 3.75);
+    EXPECT_DOUBLE_EQ(static_cast<double>(Q16_16(1.5) - Q16_16(2.25)), -0.75);
+    EXPECT_DOUBLE_EQ(static_cast<double>(Q16_16(1.5) * Q16_16(-2.5)), -3.75);
+    EXPECT_NEAR(static_cast<double>(Q16_16(1.0) / Q16_16(3.0)), 1.0 / 3.0, Q16_16::resolution() / 2);
+    EXPECT_NEAR(static_cast<double>(Q32_32(-1.0) / Q32_32(3.0)), -1.0 / 3.0, Q32_32::resolution() / 2);
+}
+
+TEST(FixedPointTest, SaturatesInsteadOfWrapping)
+{
+    EXPECT_EQ(Q16_16(30000.0) + Q16_16(30000.0), Q16_16::max());
+    EXPECT_EQ(Q16_16(-30000.0) - Q16_16(30000.0), Q16_16::min());
+    EXPECT_EQ(Q16_16(1000.0) * Q16_16(1000.0), Q16_16::max());
+    EXPECT_EQ(Q16_16(-1000.0) * Q16_16(1000.0), Q16_16::min());
+    EXPECT_EQ(-Q16_16::min(), Q16_16::max());
+    EXPECT_EQ(Q16_16(1e9), Q16_16::max());
+    EXPECT_EQ(Q32_32(1e12), Q32_32::max());
+}
+
+TEST(FixedPointTest, DivisionByZeroSaturatesTowardsSign)
+{
+    EXPECT_EQ(Q16_16(2.0) / Q16_16(0.0), Q16_16::max());
+    EXPECT_EQ(Q16_16(-2.0) / Q16_16(0.0), Q16_16::min());
+    EXPECT_EQ(Q16_16(0.0) / Q16_16(0.0), Q16_16(0.0));
+}
+
+TEST(FixedPointTest, SineMatchesStdSin)
+{
+    for (double x = -10.0; x <= 10.0; x += 0.01)
+    {
+        EXPECT_NEAR(static_cast<double>(sin(Q32_32(x))), std::sin(x), 1e-8) << x;
+        EXPECT_NEAR(static_cast<double>(sin(Q16_16(x))), std::sin(x), 2e-4) << x;
+    }
+}
+
+// Runs the main_plant scenario for Plant<Scalar> and returns the largest
+// deviation of the output trajectory from the double-precision run.
+template <template <typename> class Plant, typename Scalar>
+double maxDeviationFromDouble(double Kp, double Ki, double Kd, double setpoint, int steps)
+{
+    Plant<double> referencePlant;
+    BasicPID<double> referencePid(Kp, Ki, Kd);
+    Plant<Scalar> plant;
+    BasicPID<Scalar> pid{Scalar(Kp), Scalar(Ki), Scalar(Kd)};
+
+    double deviation = 0.0;
+    for (int i = 0; i < steps; ++i)
+    {
+        double expected = referencePlant.update(referencePid.control(setpoint - referencePlant.getOutput()));
+        Scalar actual = plant.update(pid.control(Scalar(setpoint) - plant.getOutput()));
+        deviation = std::max(deviation, std::fabs(static_cast<double>(actual) - expected));
+    }
+    return deviation;
+}
+
+template <typename Scalar>
+class ScalarAccuracyTest : public ::testing::Test
+{
+};
+
+struct FloatTolerance
+{
+    using type = float;
+    static constexpr double tolerance = 1e-5;
+};
+
+struct Q16Tolerance
+{
+    using type = Q16_16;
+    static constexpr double tolerance = 3e-2;
+};
+
+struct Q32Tolerance
+{
+    using type = Q32_32;
+    static constexpr double tolerance = 1e-6;
+};
+
+using ScalarTypes = ::testing::Types<FloatTolerance, Q16Tolerance, Q32Tolerance>;
+TYPED_TEST_SUITE(ScalarAccuracyTest, ScalarTypes);
+
+TYPED_TEST(ScalarAccuracyTest, PositionTracksDouble)
+{
+    using Scalar = typename TypeParam::type;
+    EXPECT_LT((maxDeviationFromDouble<BasicPositionSystem, Scalar>(1.0, 0.1, 0.05, 1.0, 100)), TypeParam::tolerance);
+}
+
+TYPED_TEST(ScalarAccuracyTest, VelocityTracksDouble)
+{
+    using Scalar = typename TypeParam::type;
+    EXPECT_LT((maxDeviationFromDouble<BasicVelocitySystem, Scalar>(1.0, 0.1, 0.05, 1.0, 100)), TypeParam::tolerance);
+}
+
+TYPED_TEST(ScalarAccuracyTest, TemperatureTracksDouble)
+{
+    using Scalar = typename TypeParam::type;
+    // Relative to the 100 degree setpoint
+    EXPECT_LT((maxDeviationFromDouble<BasicTemperatureSystem, Scalar>(1.0, 0.1, 0.05, 100.0, 100)) / 100.0, TypeParam::tolerance);
+}
+
+TYPED_TEST(ScalarAccuracyTest, PendulumTracksDouble)
+{
+    using Scalar = typename TypeParam::type;
+    EXPECT_LT((maxDeviationFromDouble<BasicInvertedPendulumSystem, Scalar>(30.0, 1.0, 5.0, 0.0, 100)), TypeParam::tolerance);
+}
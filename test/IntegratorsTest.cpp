@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cmath>
+#include "InvertedPendulumSystem.h"
+
+namespace
+{
+    constexpr double duration = 20.0;
+
+    // Free swing from the initial 0.1 rad for `duration` seconds
+    double finalAngle(Integrator integrator, double time_step, IntegrationStats *stats = nullptr,
+                      AdaptiveTolerance tolerance = AdaptiveTolerance())
+    {
+        BasicInvertedPendulumSystem<double> pendulum(time_step);
+        pendulum.setIntegrator(integrator, tolerance);
+
+        long long steps = std::llround(duration / time_step);
+        for (long long i = 0; i < steps; ++i)
+            pendulum.update(0.0);
+
+        if (stats)
+            *stats = pendulum.integrationStats();
+        return pendulum.getOutput();
+    }
+
+    double referenceAngle()
+    {
+        static const double reference = finalAngle(Integrator::RK4, 1e-4);
+        return reference;
+    }
+}
+
+TEST(IntegratorsTest, DefaultIsTheOriginalSemiImplicitEuler)
+{
+    BasicInvertedPendulumSystem<double> pendulum;
+    double angle = 0.1, angularVel = 0.0;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        double torque = 0.5 * i;
+        double angularAcc = (torque - 9.81 * std::sin(angle) * 1.0) / 1.0;
+        angularVel += angularAcc * 0.01;
+        angle += angularVel * 0.01;
+
+        ASSERT_EQ(pendulum.update(torque), angle);
+    }
+    EXPECT_EQ(pendulum.integrationStats().steps, 100);
+}
+
+TEST(IntegratorsTest, RK4IsFourthOrder)
+{
+    double coarse = std::fabs(finalAngle(Integrator::RK4, 0.1) - referenceAngle());
+    double fine = std::fabs(finalAngle(Integrator::RK4, 0.05) - referenceAngle());
+
+    // Halving the step should cut the error by about 2^4
+    EXPECT_GT(coarse / fine, 10.0);
+}
+
+TEST(IntegratorsTest, ExplicitEulerIsFirstOrder)
+{
+    double coarse = std::fabs(finalAngle(Integrator::ExplicitEuler, 0.002) - referenceAngle());
+    double fine = std::fabs(finalAngle(Integrator::ExplicitEuler, 0.001) - referenceAngle());
+
+    EXPECT_NEAR(coarse / fine, 2.0, 0.3);
+}
+
+TEST(IntegratorsTest, RK45ReachesToleranceWithFarFewerEvaluations)
+{
+    IntegrationStats euler, adaptive;
+    double eulerError = std::fabs(finalAngle(Integrator::SemiImplicitEuler, 0.001, &euler) - referenceAngle());
+    double adaptiveError = std::fabs(finalAngle(Integrator::RK45, 0.5, &adaptive, {1e-8, 1e-8}) - referenceAngle());
+
+    EXPECT_LT(adaptiveError, 1e-6);
+    EXPECT_GT(eulerError, 1e-5);
+    EXPECT_LT(adaptive.derivativeEvaluations * 4, euler.derivativeEvaluations);
+
+    EXPECT_GT(adaptive.steps, 0);
+    EXPECT_GT(adaptive.maxErrorEstimate, 0.0);
+    EXPECT_LT(adaptive.maxErrorEstimate, 1e-7);
+}
+
+TEST(IntegratorsTest, RK45TakesSeveralSubstepsPerLargeUpdate)
+{
+    BasicInvertedPendulumSystem<double> pendulum(1.0);
+    pendulum.setIntegrator(Integrator::RK45, {1e-10, 1e-10});
+    pendulum.update(0.0);
+
+    EXPECT_GT(pendulum.integrationStats().steps, 1);
+}
+
+TEST(IntegratorsTest, RK45GivesUpOnAnUnreachableToleranceInsteadOfStalling)
+{
+    // Zero tolerance: no step with a nonzero error estimate can pass, however small
+    BasicInvertedPendulumSystem<double> pendulum(0.01);
+    pendulum.setIntegrator(Integrator::RK45, {0.0, 0.0});
+    BasicInvertedPendulumSystem<double> reference(0.01);
+    reference.setIntegrator(Integrator::RK4);
+    for (int i = 0; i < 10; ++i)
+    {
+        pendulum.update(0.0);
+        reference.update(0.0);
+    }
+
+    const IntegrationStats &stats = pendulum.integrationStats();
+    EXPECT_EQ(stats.toleranceFailures, 10);
+    EXPECT_LE(stats.rejectedSteps, 10 * rk45MaxRejections);
+    // Still integrated with the step size that was in use, just without error control
+    EXPECT_NEAR(pendulum.getOutput(), reference.getOutput(), 1e-9);
+}
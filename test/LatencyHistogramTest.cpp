@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "BasicPID.h"
+#include "LatencyHistogram.h"
+#include "LoopInstrumentation.h"
+#include "PositionSystem.h"
+#include "Simulation.h"
+
+TEST(LatencyHistogramTest, BucketsKeepRelativeErrorBelowOnePart128)
+{
+    for (uint64_t value : {0ull, 1ull, 127ull, 128ull, 129ull, 1000ull, 123456789ull, 1ull << 40})
+    {
+        uint64_t representative = LatencyHistogram::highestEquivalentValue(LatencyHistogram::bucketOf(value));
+        EXPECT_GE(representative, value);
+        EXPECT_LE(representative - value, value / 128) << value;
+    }
+
+    // Adjacent buckets tile the range without gaps
+    for (size_t bucket = 0; bucket + 1 < 2000; ++bucket)
+        EXPECT_EQ(LatencyHistogram::bucketOf(LatencyHistogram::highestEquivalentValue(bucket) + 1), bucket + 1);
+}
+
+TEST(LatencyHistogramTest, PercentilesOfAUniformSample)
+{
+    LatencyHistogram histogram;
+    for (uint64_t v = 1; v <= 10000; ++v)
+        histogram.record(v);
+
+    EXPECT_EQ(histogram.count(), 10000u);
+    EXPECT_EQ(histogram.min(), 1u);
+    EXPECT_EQ(histogram.max(), 10000u);
+    EXPECT_DOUBLE_EQ(histogram.mean(), 5000.5);
+    EXPECT_NEAR(static_cast<double>(histogram.percentile(50.0)), 5000.0, 5000.0 / 128);
+    EXPECT_NEAR(static_cast<double>(histogram.percentile(99.0)), 9900.0, 9900.0 / 128);
+    EXPECT_NEAR(static_cast<double>(histogram.percentile(99.9)), 9990.0, 9990.0 / 128);
+    EXPECT_EQ(histogram.percentile(100.0), 10000u);
+
+    LatencySnapshot s = histogram.snapshot();
+    EXPECT_EQ(s.p50, histogram.percentile(50.0));
+    EXPECT_EQ(s.p999, histogram.percentile(99.9));
+
+    histogram.reset();
+    EXPECT_EQ(histogram.count(), 0u);
+    EXPECT_EQ(histogram.percentile(99.0), 0u);
+    EXPECT_EQ(histogram.min(), 0u);
+}
+
+TEST(LatencyHistogramTest, ConcurrentRecordingLosesNothing)
+{
+    LatencyHistogram histogram;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back([&, t]()
+                             {
+            for (uint64_t i = 0; i < 50000; ++i)
+                histogram.record(i + t * 1000000); });
+    for (auto &thread : threads)
+        thread.join();
+
+    EXPECT_EQ(histogram.count(), 200000u);
+    EXPECT_EQ(histogram.min(), 0u);
+    EXPECT_EQ(histogram.max(), 3000000u + 49999u);
+}
+
+TEST(LatencyHistogramTest, ReporterWritesPeriodicAndFinalSnapshots)
+{
+    LatencyHistogram a, b;
+    a.record(100);
+    b.record(std::chrono::microseconds(3));
+
+    std::ostringstream out;
+    {
+        LatencyReporter reporter(out, std::chrono::milliseconds(5));
+        reporter.add("a", a);
+        reporter.add("b", b);
+        reporter.start();
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        reporter.stop();
+        EXPECT_GE(reporter.reports(), 2);
+    }
+
+    EXPECT_THAT(out.str(), ::testing::HasSubstr("a count=1 min=100 mean=100 p50=100 p90=100 p99=100 p99.9=100 max=100\n"));
+    EXPECT_THAT(out.str(), ::testing::HasSubstr("b count=1 min=3000"));
+}
+
+TEST(LatencyHistogramTest, SimulateRecordsEveryPhaseOfEveryStep)
+{
+    PositionSystem plant;
+    BasicPID<double> pid(1.0, 0.1, 0.05);
+    LoopInstrumentation<> instrumentation;
+
+    simulate(plant, pid, 1.0, 20, Pacing::realtime(0.001), [](const StepSample &) {}, instrumentation);
+
+    EXPECT_EQ(instrumentation.control().count(), 20u);
+    EXPECT_EQ(instrumentation.plantUpdate().count(), 20u);
+    EXPECT_EQ(instrumentation.observer().count(), 20u);
+    EXPECT_EQ(instrumentation.wakeup().count(), 20u);
+    EXPECT_LT(instrumentation.control().percentile(50.0), 1000000u); // well under a millisecond
+
+    std::ostringstream out;
+    LatencyReporter reporter(out, std::chrono::hours(1));
+    instrumentation.addTo(reporter, "position");
+    reporter.start();
+    reporter.stop();
+    EXPECT_THAT(out.str(), ::testing::HasSubstr("position.wakeup count=20"));
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+TEST(LatencyHistogramTest, TscCalibrationHappensBeforeTheFirstTimedStep)
+{
+    // The 20 ms calibration belongs to construction, not to the first recorded phase
+    LoopInstrumentation<TscClockSource> instrumentation;
+    auto wallStart = std::chrono::steady_clock::now();
+    instrumentation.stop(LoopPhase::Control, instrumentation.start());
+    auto wallEnd = std::chrono::steady_clock::now();
+
+    EXPECT_LT(wallEnd - wallStart, std::chrono::milliseconds(10));
+    EXPECT_EQ(instrumentation.control().count(), 1u);
+}
+
+TEST(LatencyHistogramTest, TscClockAgreesWithSteadyClock)
+{
+    auto wallStart = std::chrono::steady_clock::now();
+    TscClockSource::Stamp tscStart = TscClockSource::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    TscClockSource::Stamp tscEnd = TscClockSource::now();
+    auto wallEnd = std::chrono::steady_clock::now();
+
+    double wall = static_cast<double>(SteadyClockSource::nanoseconds(wallStart, wallEnd));
+    EXPECT_NEAR(static_cast<double>(TscClockSource::nanoseconds(tscStart, tscEnd)), wall, 0.05 * wall);
+}
+#endif
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cmath>
+#include "FixedPoint.h"
+#include "PositionSystem.h"
+#include "TemperatureSystem.h"
+#include "VelocitySystem.h"
+
+namespace
+{
+    // Relative agreement, with an absolute floor for values near zero
+    ::testing::AssertionResult closeTo(double actual, double expected, double tolerance = 1e-12)
+    {
+        double scale = std::max(1.0, std::fabs(expected));
+        if (std::fabs(actual - expected) <= tolerance * scale)
+            return ::testing::AssertionSuccess();
+        return ::testing::AssertionFailure() << actual << " vs " << expected;
+    }
+
+    template <typename Plant>
+    void expectAdvanceMatchesUpdates(Plant stepped, Plant jumped, double controlSignal, long long nSteps)
+    {
+        for (long long i = 0; i < nSteps; ++i)
+            stepped.update(controlSignal);
+
+        // Stepping accumulates one rounding error per update, the closed form does not
+        double jumpedOutput = jumped.advance(controlSignal, nSteps);
+        EXPECT_TRUE(closeTo(jumpedOutput, stepped.getOutput(), 1e-14 * (1 + nSteps))) << "after " << nSteps << " steps";
+        EXPECT_EQ(jumpedOutput, jumped.getOutput());
+    }
+
+    // Fixed-point version: N and the intermediate products are far outside the
+    // Scalar's range even though the state is not
+    template <typename Plant, typename Scalar>
+    void expectFixedPointAdvanceMatchesUpdates(double controlSignal, long long nSteps, double tolerance)
+    {
+        Plant stepped, jumped;
+        for (long long i = 0; i < nSteps; ++i)
+            stepped.update(Scalar(controlSignal));
+        Scalar jumpedOutput = jumped.advance(Scalar(controlSignal), nSteps);
+        EXPECT_NEAR(static_cast<double>(jumpedOutput), static_cast<double>(stepped.getOutput()), tolerance);
+    }
+}
+
+class LinearPlantAdvanceTest : public ::testing::TestWithParam<long long>
+{
+};
+
+TEST_P(LinearPlantAdvanceTest, PositionMatchesRepeatedUpdate)
+{
+    PositionSystem plant;
+    plant.update(0.7); // non-zero initial velocity
+    expectAdvanceMatchesUpdates(plant, plant, -0.3, GetParam());
+}
+
+TEST_P(LinearPlantAdvanceTest, VelocityMatchesRepeatedUpdate)
+{
+    VelocitySystem plant;
+    plant.update(2.0);
+    expectAdvanceMatchesUpdates(plant, plant, 1.25, GetParam());
+}
+
+TEST_P(LinearPlantAdvanceTest, TemperatureMatchesRepeatedUpdate)
+{
+    TemperatureSystem plant(0.05);
+    expectAdvanceMatchesUpdates(plant, plant, -4.0, GetParam());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    StepCounts,
+    LinearPlantAdvanceTest,
+    ::testing::Values(0, 1, 2, 7, 100, 12345, 1000000));
+
+TEST(LinearPlantTest, NonPositiveStepCountsChangeNothing)
+{
+    PositionSystem position;
+    VelocitySystem velocity;
+    TemperatureSystem temperature;
+    position.advance(1.0, 10);
+    velocity.advance(1.0, 10);
+    temperature.advance(1.0, 10);
+
+    double before[] = {position.getOutput(), velocity.getOutput(), temperature.getOutput()};
+    for (long long n : {0LL, -1LL, -1000LL})
+    {
+        EXPECT_EQ(position.advance(3.0, n), before[0]);
+        EXPECT_EQ(velocity.advance(3.0, n), before[1]);
+        EXPECT_EQ(temperature.advance(3.0, n), before[2]);
+    }
+}
+
+TEST(LinearPlantTest, AdvanceContinuesFromCurrentState)
+{
+    PositionSystem split, whole;
+    split.advance(1.0, 30);
+    split.advance(-2.0, 70);
+
+    for (int i = 0; i < 30; ++i)
+        whole.update(1.0);
+    for (int i = 0; i < 70; ++i)
+        whole.update(-2.0);
+
+    EXPECT_TRUE(closeTo(split.getOutput(), whole.getOutput()));
+    EXPECT_TRUE(closeTo(split.update(0.0), whole.update(0.0)));
+}
+
+TEST(LinearPlantTest, FixedPointAdvanceDoesNotSaturate)
+{
+    expectFixedPointAdvanceMatchesUpdates<BasicVelocitySystem<Q16_16>, Q16_16>(0.01, 100000, 1e-3);
+    expectFixedPointAdvanceMatchesUpdates<BasicTemperatureSystem<Q16_16>, Q16_16>(0.01, 100000, 1e-3);
+    expectFixedPointAdvanceMatchesUpdates<BasicPositionSystem<Q16_16>, Q16_16>(0.01, 1000, 1e-3);
+    expectFixedPointAdvanceMatchesUpdates<BasicVelocitySystem<Q32_32>, Q32_32>(-0.3, 1000000, 1e-6);
+    expectFixedPointAdvanceMatchesUpdates<BasicPositionSystem<Q32_32>, Q32_32>(0.0001, 100000, 1e-3);
+}
@@ -0,0 +1,261 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "MemoryArena.h"
+#include "MyString.h"
+
+namespace
+{
+    /// Forwards to new/delete and counts what passes through.
+    class CountingResource : public std::pmr::memory_resource
+    {
+    public:
+        int allocations = 0;
+        int deallocations = 0;
+        size_t largestBlock = 0;
+
+    private:
+        void *do_allocate(size_t bytes, size_t alignment) override
+        {
+            ++allocations;
+            largestBlock = std::max(largestBlock, bytes);
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void *p, size_t bytes, size_t alignment) override
+        {
+            ++deallocations;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    /// Hands out `remaining` blocks from new/delete, then throws std::bad_alloc.
+    class LimitedResource : public std::pmr::memory_resource
+    {
+    public:
+        explicit LimitedResource(int remaining) : remaining(remaining) {}
+
+        int remaining;
+
+    private:
+        void *do_allocate(size_t bytes, size_t alignment) override
+        {
+            if (remaining == 0)
+                throw std::bad_alloc();
+            --remaining;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void *p, size_t bytes, size_t alignment) override
+        {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    const char *const longText = "a string too long for the inline buffer";
+}
+
+TEST(MonotonicArenaTest, BumpAllocatesWithAlignment)
+{
+    CountingResource upstream;
+    MonotonicArena arena(1024, &upstream);
+
+    char *a = static_cast<char *>(arena.allocate(3, 1));
+    char *b = static_cast<char *>(arena.allocate(8, 8));
+    char *c = static_cast<char *>(arena.allocate(1, 1));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % 8, 0u);
+    EXPECT_GE(b, a + 3);
+    EXPECT_EQ(c, b + 8);
+    EXPECT_EQ(upstream.allocations, 1);
+}
+
+TEST(MonotonicArenaTest, GrowsByChunksAndReleasesInBulk)
+{
+    CountingResource upstream;
+    {
+        MonotonicArena arena(256, &upstream);
+        for (int i = 0; i < 100; ++i)
+            arena.deallocate(arena.allocate(64, 8), 64, 8);
+        EXPECT_GT(arena.chunkCount(), 1u);
+        EXPECT_LT(arena.chunkCount(), 8u);
+        EXPECT_EQ(upstream.deallocations, 0);
+
+        EXPECT_NE(arena.allocate(100000, 16), nullptr);
+        EXPECT_GE(arena.bytesUsed(), 100 * 64 + 100000u);
+
+        arena.release();
+        EXPECT_EQ(upstream.deallocations, upstream.allocations);
+        EXPECT_EQ(arena.bytesUsed(), 0u);
+
+        EXPECT_NE(arena.allocate(8, 8), nullptr);
+    }
+    EXPECT_EQ(upstream.deallocations, upstream.allocations);
+}
+
+TEST(MonotonicArenaTest, ReleaseRestartsFromTheInitialChunkSize)
+{
+    CountingResource upstream;
+    MonotonicArena arena(4096, &upstream);
+
+    // A request-sized workload that needs a second chunk every cycle
+    for (int cycle = 0; cycle < 20; ++cycle)
+    {
+        EXPECT_NE(arena.allocate(5000, 8), nullptr);
+        arena.release();
+    }
+    EXPECT_EQ(upstream.allocations, 20);
+    EXPECT_LE(upstream.largestBlock, 16384u);
+}
+
+TEST(MonotonicArenaTest, InitialBufferAvoidsUpstream)
+{
+    CountingResource upstream;
+    alignas(16) char buffer[512];
+    MonotonicArena arena(buffer, sizeof(buffer), &upstream);
+
+    void *p = arena.allocate(100, 1);
+    EXPECT_GE(static_cast<char *>(p), buffer);
+    EXPECT_LT(static_cast<char *>(p), buffer + sizeof(buffer));
+    EXPECT_EQ(upstream.allocations, 0);
+
+    EXPECT_NE(arena.allocate(1000, 1), nullptr);
+    EXPECT_EQ(upstream.allocations, 1);
+
+    arena.release();
+    EXPECT_EQ(arena.allocate(10, 1), static_cast<void *>(buffer));
+}
+
+TEST(MonotonicArenaTest, MyStringAllocatesFromTheArena)
+{
+    CountingResource upstream;
+    MonotonicArena arena(4096, &upstream);
+    {
+        MyString a(longText, &arena);
+        MyString b = MyString(longText, &arena) + a;
+        MyString c(&arena);
+        for (int i = 0; i < 20; ++i)
+            c += a;
+
+        EXPECT_EQ(a.get_allocator().resource(), &arena);
+        EXPECT_STREQ(a.c_str(), longText);
+        EXPECT_EQ(b.size(), 2 * a.size());
+        EXPECT_EQ(c.size(), 20 * a.size());
+        EXPECT_GT(arena.bytesUsed(), 0u);
+    }
+    EXPECT_EQ(upstream.allocations, 1);
+}
+
+TEST(MonotonicArenaTest, CopiesUseTheDefaultResourceUnlessGivenOne)
+{
+    MonotonicArena arena;
+    MyString a(longText, &arena);
+
+    MyString copy(a);
+    EXPECT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+
+    MyString arenaCopy(a, &arena);
+    EXPECT_EQ(arenaCopy.get_allocator().resource(), &arena);
+    EXPECT_STREQ(arenaCopy.c_str(), longText);
+}
+
+TEST(MonotonicArenaTest, MovesAdoptStorageOnlyFromTheSameResource)
+{
+    MonotonicArena arena;
+    MonotonicArena other;
+
+    MyString a(longText, &arena);
+    const char *data = a.c_str();
+    MyString sameResource(std::move(a), &arena);
+    EXPECT_EQ(sameResource.c_str(), data);
+
+    MyString otherResource(std::move(sameResource), &other);
+    EXPECT_NE(otherResource.c_str(), data);
+    EXPECT_STREQ(otherResource.c_str(), longText);
+    EXPECT_STREQ(sameResource.c_str(), "");
+
+    MyString target(&arena);
+    target = std::move(otherResource);
+    EXPECT_EQ(target.get_allocator().resource(), &arena);
+    EXPECT_STREQ(target.c_str(), longText);
+}
+
+TEST(MonotonicArenaTest, FailedCrossResourceMoveLeavesBothStringsIntact)
+{
+    MonotonicArena arena;
+    MyString source(longText, &arena);
+
+    // null_memory_resource() throws on every allocation
+    MyString target("short", std::pmr::null_memory_resource());
+    static_assert(!std::is_nothrow_move_assignable<MyString>::value, "may allocate across resources");
+    EXPECT_THROW(target = std::move(source), std::bad_alloc);
+    EXPECT_STREQ(target.c_str(), "short");
+    EXPECT_STREQ(source.c_str(), longText);
+}
+
+TEST(MonotonicArenaTest, FailedCopyAssignmentLeavesTheTargetIntact)
+{
+    LimitedResource limited(1);
+    MyString target(longText, &limited);
+    EXPECT_EQ(limited.remaining, 0);
+
+    // Needs a new block, which the resource refuses
+    MyString other("another string too long for the inline buffer");
+    EXPECT_THROW(target = other, std::bad_alloc);
+    EXPECT_STREQ(target.c_str(), longText);
+    EXPECT_EQ(target.get_allocator().resource(), &limited);
+
+    // Short strings are stored inline and need no block
+    MyString shortString("short");
+    target = shortString;
+    EXPECT_STREQ(target.c_str(), "short");
+}
+
+TEST(MonotonicArenaTest, PmrContainersPassTheirResourceToMyString)
+{
+    CountingResource upstream;
+    MonotonicArena arena(1 << 16, &upstream);
+    {
+        std::pmr::vector<MyString> strings(&arena);
+        for (int i = 0; i < 100; ++i)
+            strings.emplace_back(longText);
+
+        for (const MyString &s : strings)
+            EXPECT_EQ(s.get_allocator().resource(), &arena);
+    }
+    EXPECT_EQ(upstream.allocations, 1);
+}
+
+TEST(ThreadLocalPoolTest, EachThreadHasItsOwnPool)
+{
+    std::pmr::memory_resource *mine = threadLocalPool();
+    std::pmr::memory_resource *theirs = nullptr;
+    std::thread([&]()
+                {
+        theirs = threadLocalPool();
+        MyString s(longText, theirs);
+        s += s; })
+        .join();
+
+    EXPECT_EQ(threadLocalPool(), mine);
+    EXPECT_NE(mine, theirs);
+
+    MyString s(longText, mine);
+    EXPECT_STREQ(s.c_str(), longText);
+}
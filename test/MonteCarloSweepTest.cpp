@@ -0,0 +1,218 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include "CounterRng.h"
+#include "InvertedPendulumSystem.h"
+#include "MonteCarloSweep.h"
+#include "PID.h"
+#include "Simulation.h"
+
+namespace
+{
+    bool sameBits(double a, double b)
+    {
+        return std::memcmp(&a, &b, sizeof(double)) == 0;
+    }
+
+    void expectSameSummary(const MetricSummary &a, const MetricSummary &b)
+    {
+        EXPECT_EQ(a.count(), b.count());
+        EXPECT_TRUE(sameBits(a.mean(), b.mean()));
+        EXPECT_TRUE(sameBits(a.stddev(), b.stddev()));
+        EXPECT_TRUE(sameBits(a.min(), b.min()));
+        EXPECT_TRUE(sameBits(a.max(), b.max()));
+        EXPECT_EQ(a.histogram().bins(), b.histogram().bins());
+    }
+
+    SweepProblem variedPendulum()
+    {
+        SweepProblem problem;
+        problem.space.timeStep = Distribution::uniform(0.005, 0.02);
+        problem.space.length = Distribution::uniform(0.8, 1.2);
+        problem.space.inertia = Distribution::normal(1.0, 0.05);
+        problem.space.initialAngle = Distribution::uniform(-0.2, 0.2);
+        problem.space.Kp = Distribution::uniform(20.0, 40.0);
+        problem.space.Ki = Distribution::fixed(1.0);
+        problem.space.Kd = Distribution::uniform(3.0, 6.0);
+        problem.duration = 1.0;
+        return problem;
+    }
+}
+
+TEST(CounterRngTest, PhiloxMatchesTheReferenceVectors)
+{
+    // Known-answer tests from the Random123 distribution
+    EXPECT_EQ(philox4x32({0, 0, 0, 0}, {0, 0}), (std::array<uint32_t, 4>{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+    EXPECT_EQ(philox4x32({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff}),
+              (std::array<uint32_t, 4>{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+    EXPECT_EQ(philox4x32({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0}),
+              (std::array<uint32_t, 4>{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+}
+
+TEST(CounterRngTest, StreamsAreReproducibleAndDistinct)
+{
+    CounterRng a(7, 3), b(7, 3), other(7, 4);
+    for (int i = 0; i < 10; ++i)
+    {
+        uint64_t value = a.next();
+        EXPECT_EQ(value, b.next());
+        EXPECT_NE(value, other.next());
+    }
+}
+
+TEST(CounterRngTest, UniformCoversTheUnitInterval)
+{
+    CounterRng rng(1, 0);
+    double sum = 0.0, low = 1.0, high = 0.0;
+    const int n = 100000;
+    for (int i = 0; i < n; ++i)
+    {
+        double u = rng.uniform();
+        ASSERT_GE(u, 0.0);
+        ASSERT_LT(u, 1.0);
+        sum += u;
+        low = std::min(low, u);
+        high = std::max(high, u);
+    }
+    EXPECT_NEAR(sum / n, 0.5, 0.01);
+    EXPECT_LT(low, 1e-3);
+    EXPECT_GT(high, 1.0 - 1e-3);
+}
+
+TEST(MonteCarloSweepTest, PendulumParametersDefaultToTheStockPendulum)
+{
+    InvertedPendulumSystem stock, explicitParameters(0.01, 1.0, 9.81, 1.0, 0.1);
+    for (int i = 0; i < 100; ++i)
+        EXPECT_TRUE(sameBits(stock.update(0.3), explicitParameters.update(0.3)));
+
+    InvertedPendulumSystem longer(0.01, 1.0, 9.81, 2.0, 0.3);
+    EXPECT_EQ(longer.getOutput(), 0.3);
+    InvertedPendulumSystem shorter(0.01, 1.0, 9.81, 0.5, 0.3);
+    longer.update(0.0);
+    shorter.update(0.0);
+    EXPECT_LT(longer.getOutput(), shorter.getOutput()); // the gravity torque scales with length
+}
+
+TEST(MonteCarloSweepTest, TrialMatchesAClosedLoopThroughTheInterfaces)
+{
+    ThreadPool pool(1);
+    SweepProblem problem;
+    problem.duration = 1.0;
+    MonteCarloSweep sweep(problem, pool);
+
+    TrialParameters p = sweep.parameters(1, 0);
+    EXPECT_EQ(p.timeStep, 0.01);
+    EXPECT_EQ(p.Kp, 1.0);
+
+    TrialOutcome outcome = sweep.runTrial(p);
+
+    InvertedPendulumSystem plant;
+    PID pid(1.0, 0.1, 0.05);
+    double iae = 0.0;
+    simulate(plant, pid, 0.0, 100, Pacing::unthrottled(), [&](const StepSample &s)
+             { iae += std::fabs(s.error) * 0.01; });
+
+    EXPECT_TRUE(outcome.stable);
+    EXPECT_DOUBLE_EQ(outcome.iae, iae);
+    EXPECT_DOUBLE_EQ(outcome.finalError, std::fabs(plant.getOutput()));
+}
+
+TEST(MonteCarloSweepTest, DegenerateDurationsRunNoSteps)
+{
+    ThreadPool pool(1);
+    SweepProblem problem;
+    MonteCarloSweep sweep(problem, pool);
+    TrialParameters p = sweep.parameters(1, 0);
+
+    for (double duration : {-1.0, 0.0, std::nan("")})
+    {
+        problem.duration = duration;
+        TrialOutcome outcome = MonteCarloSweep(problem, pool).runTrial(p);
+        EXPECT_EQ(outcome.iae, 0.0);
+    }
+}
+
+TEST(MonteCarloSweepTest, ResultsDoNotDependOnTheThreadCount)
+{
+    SweepOptions options;
+    options.trials = 3000;
+    options.chunkSize = 128;
+    options.seed = 99;
+
+    ThreadPool one(1), four(4);
+    SweepResult a = MonteCarloSweep(variedPendulum(), one).run(options);
+    SweepResult b = MonteCarloSweep(variedPendulum(), four).run(options);
+
+    EXPECT_EQ(a.trials, 3000);
+    EXPECT_EQ(a.trials, b.trials);
+    EXPECT_EQ(a.unstable, b.unstable);
+    expectSameSummary(a.iae, b.iae);
+    expectSameSummary(a.overshoot, b.overshoot);
+    expectSameSummary(a.finalError, b.finalError);
+    EXPECT_EQ(a.iae.count() + a.unstable, a.trials);
+}
+
+TEST(MonteCarloSweepTest, DifferentSeedsGiveDifferentSamples)
+{
+    ThreadPool pool(2);
+    MonteCarloSweep sweep(variedPendulum(), pool);
+    SweepOptions options;
+    options.trials = 500;
+
+    SweepResult a = sweep.run(options);
+    options.seed = 2;
+    SweepResult b = sweep.run(options);
+    EXPECT_NE(a.iae.mean(), b.iae.mean());
+}
+
+TEST(MonteCarloSweepTest, MergedSummaryMatchesSequentialMoments)
+{
+    MetricSummary whole(Histogram(0.0, 10.0, 10)), left(Histogram(0.0, 10.0, 10)), right(Histogram(0.0, 10.0, 10));
+    for (int i = 0; i < 100; ++i)
+    {
+        double value = 0.1 * i;
+        whole.add(value);
+        (i < 37 ? left : right).add(value);
+    }
+    left.merge(right);
+
+    EXPECT_EQ(left.count(), 100);
+    EXPECT_NEAR(left.mean(), whole.mean(), 1e-12);
+    EXPECT_NEAR(left.stddev(), whole.stddev(), 1e-12);
+    EXPECT_EQ(left.min(), 0.0);
+    EXPECT_DOUBLE_EQ(left.max(), 9.9);
+    EXPECT_EQ(left.histogram().bins(), whole.histogram().bins());
+    EXPECT_NEAR(left.histogram().quantile(0.5), 5.0, 0.1);
+}
+
+TEST(MonteCarloSweepTest, HistogramCountsOutOfRangeValuesSeparately)
+{
+    Histogram histogram(0.0, 1.0, 4);
+    histogram.add(-0.5);
+    histogram.add(0.1);
+    histogram.add(0.6);
+    histogram.add(1.0);
+    histogram.add(7.0);
+
+    EXPECT_EQ(histogram.underflow(), 1);
+    EXPECT_EQ(histogram.overflow(), 2);
+    EXPECT_EQ(histogram.bins(), (std::vector<long long>{1, 0, 1, 0}));
+    EXPECT_EQ(histogram.count(), 5);
+    EXPECT_EQ(histogram.quantile(0.0), 0.0);
+    EXPECT_EQ(histogram.quantile(1.0), 1.0);
+}
+
+TEST(MonteCarloSweepTest, HistogramTakesNonFiniteAndHugeValues)
+{
+    Histogram histogram(0.0, 1.0, 4);
+    histogram.add(std::nan(""));
+    histogram.add(std::numeric_limits<double>::infinity());
+    histogram.add(1e300);
+    histogram.add(-std::numeric_limits<double>::infinity());
+
+    EXPECT_EQ(histogram.overflow(), 3);
+    EXPECT_EQ(histogram.underflow(), 1);
+    EXPECT_EQ(histogram.bins(), (std::vector<long long>{0, 0, 0, 0}));
+}
@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <map>
+#include <type_traits>
+#include <unordered_map>
 #include "MyString.h"
 
 TEST(MyStringTest, DefaultConstructorCreatesEmptyString)
@@ -35,12 +38,23 @@ TEST(MyStringTest, CopyAssignmentPerformsDeepCopy)
 
 TEST(MyStringTest, MoveConstructorTransfersOwnership)
 {
-    MyString a("moved");
+    MyString a("a string too long for the inline buffer");
     const char *original_ptr = a.c_str();
     MyString b(std::move(a));
-    EXPECT_STREQ(b.c_str(), "moved");
-    EXPECT_EQ(a.c_str(), nullptr);
+    EXPECT_STREQ(b.c_str(), "a string too long for the inline buffer");
     EXPECT_EQ(b.c_str(), original_ptr);
+    EXPECT_STREQ(a.c_str(), "");
+    EXPECT_EQ(a.size(), 0);
+}
+
+TEST(MyStringTest, MoveConstructorCopiesInlineCharacters)
+{
+    MyString a("moved");
+    MyString b(std::move(a));
+    EXPECT_STREQ(b.c_str(), "moved");
+    EXPECT_TRUE(b.isInline());
+    EXPECT_STREQ(a.c_str(), "");
+    EXPECT_EQ(a.size(), 0);
 }
 
 TEST(MyStringTest, MoveAssignmentTransfersOwnership)
@@ -49,7 +63,41 @@ TEST(MyStringTest, MoveAssignmentTransfersOwnership)
     MyString b("beta");
     b = std::move(a);
     EXPECT_STREQ(b.c_str(), "alpha");
-    EXPECT_EQ(a.c_str(), nullptr);
+    EXPECT_STREQ(a.c_str(), "");
+
+    MyString c("a string too long for the inline buffer");
+    const char *original_ptr = c.c_str();
+    b = std::move(c);
+    EXPECT_EQ(b.c_str(), original_ptr);
+    EXPECT_STREQ(c.c_str(), "");
+}
+
+TEST(MyStringTest, ShortStringsStayInline)
+{
+    MyString empty;
+    MyString longest("exactly15chars!");
+    MyString tooLong("sixteen chars!!!");
+    EXPECT_TRUE(empty.isInline());
+    EXPECT_TRUE(longest.isInline());
+    EXPECT_FALSE(tooLong.isInline());
+    EXPECT_EQ(longest.size(), MyString::inlineCapacity);
+}
+
+TEST(MyStringTest, CopiesCrossTheInlineHeapBoundary)
+{
+    MyString shortString("short");
+    MyString longString("a string too long for the inline buffer");
+
+    MyString a(shortString);
+    a = longString;
+    EXPECT_STREQ(a.c_str(), longString.c_str());
+    EXPECT_FALSE(a.isInline());
+
+    a = shortString;
+    EXPECT_STREQ(a.c_str(), "short");
+    EXPECT_TRUE(a.isInline());
+    EXPECT_TRUE(a == shortString);
+    EXPECT_FALSE(a == longString);
 }
 
 TEST(MyStringTest, EqualityComparison)
@@ -68,4 +116,229 @@ TEST(MyStringTest, ConcatenationOperator)
     MyString b("world");
     MyString c = a + b;
     EXPECT_STREQ(c.c_str(), "helloworld");
+}
+
+TEST(MyStringTest, ConcatenationAcrossTheInlineBoundary)
+{
+    MyString a("01234567");
+    MyString b("89abcdef");
+    MyString c = a + b;
+    EXPECT_STREQ(c.c_str(), "0123456789abcdef");
+    EXPECT_EQ(c.size(), 16);
+    EXPECT_FALSE(c.isInline());
+
+    MyString d = MyString("0123") + MyString("456");
+    EXPECT_TRUE(d.isInline());
+    EXPECT_TRUE(d == MyString("0123456"));
+}
+
+TEST(MyStringTest, StatsAreZeroWithoutTracing)
+{
+    if (MyString::tracingEnabled)
+        GTEST_SKIP() << "built with MYSTRING_TRACE";
+
+    MyString a("a string too long for the inline buffer");
+    MyString b(a);
+    EXPECT_EQ(MyString::stats().allocations, 0);
+    EXPECT_EQ(MyString::stats().copies, 0);
+}
+
+TEST(MyStringTest, ShortStringsStayWithinAZeroAllocationBudget)
+{
+    if (!MyString::tracingEnabled)
+        GTEST_SKIP() << "build with -DMYSTRING_TRACE=1 to count allocations";
+
+    MyString::resetStats();
+    {
+        MyString a("short");
+        MyString b(a);
+        MyString c(std::move(b));
+        MyString d = a + c;
+        b = d;
+    }
+    MyStringStats stats = MyString::stats();
+    EXPECT_EQ(stats.allocations, 0);
+    EXPECT_EQ(stats.copies, 2);
+    EXPECT_EQ(stats.moves, 1);
+    EXPECT_EQ(stats.destructions, 4);
+}
+
+TEST(MyStringTest, LongStringsAllocateOncePerOwnedCopy)
+{
+    if (!MyString::tracingEnabled)
+        GTEST_SKIP() << "build with -DMYSTRING_TRACE=1 to count allocations";
+
+    MyString::resetStats();
+    {
+        MyString a("a string too long for the inline buffer");
+        MyString b(a);
+        MyString c(std::move(b));
+        MyString d = a + c;
+    }
+    MyStringStats stats = MyString::stats();
+    EXPECT_EQ(stats.allocations, 3);
+    EXPECT_EQ(stats.deallocations, 3);
+    EXPECT_EQ(stats.bytesAllocated, 40 + 40 + 79);
+}
+
+TEST(MyStringTest, ConcatenationChainsMixStringsAndLiterals)
+{
+    MyString a("alpha");
+    MyString b("beta");
+    MyString c = "<" + a + ", " + b + ">";
+    EXPECT_STREQ(c.c_str(), "<alpha, beta>");
+    EXPECT_EQ(c.size(), 13);
+
+    MyString d = (a + b) + (b + a);
+    EXPECT_STREQ(d.c_str(), "alphabetabetaalpha");
+}
+
+TEST(MyStringTest, ConcatenationYieldsAnExpressionNotAString)
+{
+    MyString a("left ");
+    MyString b("right");
+    static_assert(!std::is_same<decltype(a + b), MyString>::value, "operator+ is lazy");
+
+    // Materialize before using string members
+    EXPECT_STREQ(MyString(a + b).c_str(), "left right");
+    EXPECT_EQ(MyString(a + b).size(), 10);
+
+    // An expression kept in `auto` is fine while its operands live
+    auto expression = a + b;
+    MyString s = expression;
+    EXPECT_TRUE(s == MyString("left right"));
+
+    EXPECT_TRUE(a + b == s);
+    EXPECT_TRUE(s == a + "right");
+    EXPECT_TRUE(a + b != a);
+    EXPECT_FALSE(b + a == s);
+}
+
+TEST(MyStringTest, ConcatenationChainAllocatesOnce)
+{
+    if (!MyString::tracingEnabled)
+        GTEST_SKIP() << "build with -DMYSTRING_TRACE=1 to count allocations";
+
+    MyString a("first part, ");
+    MyString b("second part, ");
+    MyString c("third part, ");
+    MyString d("fourth part");
+
+    MyString::resetStats();
+    MyString e = a + b + c + d;
+    EXPECT_STREQ(e.c_str(), "first part, second part, third part, fourth part");
+    EXPECT_EQ(MyString::stats().allocations, 1);
+    EXPECT_EQ(MyString::stats().bytesAllocated, static_cast<long long>(e.size() + 1));
+}
+
+TEST(MyStringTest, AppendGrowsGeometrically)
+{
+    MyString s;
+    EXPECT_EQ(s.capacity(), MyString::inlineCapacity);
+
+    MyString::resetStats();
+    size_t reallocations = 0;
+    size_t capacity = s.capacity();
+    for (int i = 0; i < 1000; ++i)
+    {
+        s += "x";
+        if (s.capacity() != capacity)
+        {
+            EXPECT_GE(s.capacity(), 2 * capacity);
+            capacity = s.capacity();
+            ++reallocations;
+        }
+    }
+    EXPECT_EQ(s.size(), 1000);
+    EXPECT_LE(reallocations, 7u);
+    if (MyString::tracingEnabled)
+    {
+        EXPECT_EQ(MyString::stats().allocations, static_cast<long long>(reallocations));
+    }
+}
+
+TEST(MyStringTest, ReserveAvoidsLaterGrowth)
+{
+    MyString s("abc");
+    s.reserve(100);
+    EXPECT_GE(s.capacity(), 100u);
+    const char *data = s.c_str();
+    for (int i = 0; i < 97; ++i)
+        s.append("d", 1);
+    EXPECT_EQ(s.c_str(), data);
+    EXPECT_EQ(s.size(), 100);
+    EXPECT_STREQ(s.c_str() + 96, "dddd");
+}
+
+TEST(MyStringTest, AppendMaySelfReference)
+{
+    MyString s("0123456789");
+    s += s;
+    EXPECT_STREQ(s.c_str(), "01234567890123456789");
+
+    s.append(s.c_str() + 5, 5);
+    EXPECT_STREQ(s.c_str(), "0123456789012345678956789");
+
+    MyString t("ab");
+    t += t + "-" + t;
+    EXPECT_STREQ(t.c_str(), "abab-ab");
+}
+
+TEST(MyStringTest, FindCharactersAndSubstrings)
+{
+    MyString s("the quick brown fox jumps over the lazy dog");
+    EXPECT_EQ(s.find('q'), 4u);
+    EXPECT_EQ(s.find('t', 1), 31u);
+    EXPECT_EQ(s.find('!'), MyString::npos);
+    EXPECT_EQ(s.find("the"), 0u);
+    EXPECT_EQ(s.find("the", 1), 31u);
+    EXPECT_EQ(s.find(MyString("lazy dog")), 35u);
+    EXPECT_EQ(s.find("cat"), MyString::npos);
+    EXPECT_EQ(s.find(""), 0u);
+    EXPECT_EQ(s.find("dog", 100), MyString::npos);
+}
+
+TEST(MyStringTest, CompareOrdersLexicographically)
+{
+    EXPECT_LT(MyString("apple").compare(MyString("banana")), 0);
+    EXPECT_GT(MyString("banana").compare(MyString("apple")), 0);
+    EXPECT_LT(MyString("app").compare(MyString("apple")), 0);
+    EXPECT_EQ(MyString("same").compare(MyString("same")), 0);
+    EXPECT_TRUE(MyString("a\x7f") < MyString("a\x80"));
+
+    std::map<MyString, int> sorted{{"pear", 1}, {"apple", 2}, {"fig", 3}};
+    EXPECT_STREQ(sorted.begin()->first.c_str(), "apple");
+}
+
+TEST(MyStringTest, HashIsCachedAndFollowsChanges)
+{
+    MyString a("a string too long for the inline buffer");
+    MyString b("a string too long for the inline buffer");
+    EXPECT_EQ(a.hash(), b.hash());
+    EXPECT_EQ(a.hash(), std::hash<MyString>()(a));
+
+    size_t before = a.hash();
+    a += "!";
+    EXPECT_NE(a.hash(), before);
+    EXPECT_FALSE(a == b);
+
+    MyString c(b);
+    EXPECT_EQ(c.hash(), b.hash());
+    c = a;
+    EXPECT_EQ(c.hash(), a.hash());
+
+    MyString moved(std::move(c));
+    EXPECT_EQ(moved.hash(), a.hash());
+    EXPECT_EQ(c.hash(), MyString().hash());
+}
+
+TEST(MyStringTest, WorksAsAnUnorderedMapKey)
+{
+    std::unordered_map<MyString, int> counts;
+    for (const char *word : {"alpha", "beta", "alpha", "a string too long for the inline buffer", "alpha"})
+        ++counts[MyString(word)];
+
+    EXPECT_EQ(counts.size(), 3u);
+    EXPECT_EQ(counts[MyString("alpha")], 3);
+    EXPECT_EQ(counts[MyString("a string too long for the inline buffer")], 1);
 }
\ No newline at end of file
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "PIDAutoTuner.h"
+#include "InvertedPendulumSystem.h"
+#include "PositionSystem.h"
+#include "VelocitySystem.h"
+
+class PIDAutoTunerTest : public ::testing::Test
+{
+protected:
+    ThreadPool pool{4};
+
+    TuningProblem velocityProblem()
+    {
+        TuningProblem problem;
+        problem.makePlant = []()
+        { return std::make_unique<VelocitySystem>(); };
+        problem.setpoint = 1.0;
+        problem.steps = 100;
+        problem.sampleTime = 0.1;
+        return problem;
+    }
+};
+
+TEST_F(PIDAutoTunerTest, DivergingGainsScoreAsUnstable)
+{
+    TuningProblem problem = velocityProblem();
+    problem.outputMin = -1e300;
+    problem.outputMax = 1e300;
+    PIDAutoTuner tuner(problem, pool);
+    // Kp * dt > 2 makes the unclamped velocity loop oscillate with growing amplitude
+    LoopScore score = tuner.evaluate({40.0, 0.0, 0.0});
+    EXPECT_FALSE(score.stable);
+    EXPECT_GT(score.cost, 1e12);
+}
+
+TEST_F(PIDAutoTunerTest, GridSearchReturnsBestCandidate)
+{
+    PIDAutoTuner tuner(velocityProblem(), pool);
+    TuningResult result = tuner.gridSearch({0.0, 10.0, 5}, {0.0, 1.0, 3}, {0.0, 0.0, 1});
+
+    EXPECT_EQ(result.evaluations, 15u);
+    EXPECT_LE(result.score.cost, tuner.evaluate({1.0, 0.1, 0.0}).cost);
+    EXPECT_DOUBLE_EQ(result.score.cost, tuner.evaluate(result.gains).cost);
+}
+
+TEST_F(PIDAutoTunerTest, NelderMeadImprovesOnStartPoint)
+{
+    PIDAutoTuner tuner(velocityProblem(), pool);
+    GainCandidate start{1.0, 0.1, 0.05};
+
+    TuningResult result = tuner.nelderMead(start);
+
+    EXPECT_TRUE(result.score.stable);
+    EXPECT_LT(result.score.cost, tuner.evaluate(start).cost);
+    EXPECT_GE(result.gains.Kp, 0.0);
+    EXPECT_GE(result.gains.Ki, 0.0);
+    EXPECT_GE(result.gains.Kd, 0.0);
+}
+
+TEST_F(PIDAutoTunerTest, RelayExperimentFindsPendulumOscillation)
+{
+    TuningProblem problem;
+    problem.makePlant = []()
+    { return std::make_unique<InvertedPendulumSystem>(); };
+    problem.setpoint = 0.0;
+    problem.steps = 500;
+    problem.sampleTime = 0.01;
+    PIDAutoTuner tuner(problem, pool);
+
+    std::optional<RelayResult> relay = tuner.relayExperiment(20.0, 2000);
+    ASSERT_TRUE(relay.has_value());
+    EXPECT_GT(relay->ultimateGain, 0.0);
+    EXPECT_GT(relay->ultimatePeriod, 0.0);
+
+    GainCandidate zn = tuner.zieglerNichols(*relay);
+    EXPECT_DOUBLE_EQ(zn.Kp, 0.6 * relay->ultimateGain);
+}
+
+TEST_F(PIDAutoTunerTest, TuneBeatsHandTunedPositionGains)
+{
+    TuningProblem problem;
+    problem.makePlant = []()
+    { return std::make_unique<PositionSystem>(); };
+    problem.steps = 200;
+    CostWeights weights;
+    weights.overshoot = 1.0;
+    PIDAutoTuner tuner(problem, pool, weights);
+
+    TuningResult result = tuner.tune();
+
+    EXPECT_TRUE(result.score.stable);
+    EXPECT_LT(result.score.cost, tuner.evaluate({1.0, 0.1, 0.05}).cost);
+    EXPECT_GT(result.evaluations, 0u);
+}
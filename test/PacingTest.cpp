@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <chrono>
+#include <thread>
+#include "Pacing.h"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    double secondsSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+}
+
+TEST(PacingTest, UnthrottledNeverWaits)
+{
+    Pacer pacer(Pacing::unthrottled(0.05));
+    auto start = Clock::now();
+    for (int i = 0; i < 1000; ++i)
+        pacer.waitForNextStep();
+
+    // 1000 steps would take 50 s in real time; the bound only has to rule that out
+    EXPECT_LT(secondsSince(start), 5.0);
+    EXPECT_EQ(pacer.stats().steps, 1000);
+    EXPECT_EQ(pacer.stats().overruns, 0);
+}
+
+TEST(PacingTest, AcceleratedDividesThePeriod)
+{
+    Pacing pacing = Pacing::accelerated(10.0, 0.05);
+    EXPECT_EQ(pacing.wallPeriod(), std::chrono::milliseconds(5));
+    EXPECT_DOUBLE_EQ(pacing.samplingPeriod(), 0.05);
+
+    Pacer pacer(pacing);
+    auto start = Clock::now();
+    for (int i = 0; i < 20; ++i)
+        pacer.waitForNextStep();
+
+    // 0.1 s accelerated versus 1 s in real time; generous for loaded machines
+    double elapsed = secondsSince(start);
+    EXPECT_GE(elapsed, 0.1);
+    EXPECT_LT(elapsed, 0.9);
+    EXPECT_EQ(pacer.stats().steps, 20);
+}
+
+TEST(PacingTest, RealtimeDoesNotDriftWithLoopWork)
+{
+    // 5 ms period with 4 ms of work per step: relative sleeps would take at least
+    // 9 ms per step (0.36 s in total) against 0.2 s on an absolute schedule
+    Pacer pacer(Pacing::realtime(0.005));
+    auto start = Clock::now();
+    for (int i = 0; i < 40; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(4));
+        pacer.waitForNextStep();
+    }
+
+    double elapsed = secondsSince(start);
+    EXPECT_GE(elapsed, 0.2);
+    EXPECT_LT(elapsed, 0.34);
+}
+
+TEST(PacingTest, OverrunsAreCountedAndTheScheduleCatchesUp)
+{
+    Pacer pacer(Pacing::realtime(0.002));
+    auto start = Clock::now();
+
+    // One long step blows through several deadlines...
+    std::this_thread::sleep_for(std::chrono::milliseconds(7));
+    pacer.waitForNextStep();
+    EXPECT_EQ(pacer.stats().overruns, 1);
+    EXPECT_GE(pacer.stats().maxOverrun, std::chrono::milliseconds(4));
+
+    // ...and the following steps run back to back until the schedule is met again:
+    // the deadlines at 4 and 6 ms have passed too, so they count as overruns
+    for (int i = 0; i < 9; ++i)
+        pacer.waitForNextStep();
+
+    EXPECT_EQ(pacer.stats().steps, 10);
+    EXPECT_GE(pacer.stats().overruns, 3);
+
+    // The last deadline stays at 10 periods from the start rather than shifting by the overrun
+    double elapsed = secondsSince(start);
+    EXPECT_GE(elapsed, 0.02);
+    EXPECT_LT(elapsed, 0.5);
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "BasicPID.h"
+#include "InvertedPendulumSystem.h"
+#include "PlantBatch.h"
+#include "PositionSystem.h"
+#include "TemperatureSystem.h"
+#include "VectorMath.h"
+#include "VelocitySystem.h"
+
+namespace
+{
+    constexpr size_t lanes = 11; // not a multiple of the vector width
+
+    // Runs a PID loop on every lane of the batch and on an equivalent
+    // single-instance plant, and returns the largest output difference.
+    template <typename Batch, typename Plant>
+    double maxLaneDeviation(Batch &batch, std::vector<Plant> &plants, double Kp, double Ki, double Kd,
+                            double setpoint, int steps)
+    {
+        std::vector<BasicPID<double>> batchPids(lanes, BasicPID<double>(Kp, Ki, Kd));
+        std::vector<BasicPID<double>> plantPids = batchPids;
+        std::vector<double> control(lanes);
+
+        double deviation = 0.0;
+        for (int step = 0; step < steps; ++step)
+        {
+            for (size_t i = 0; i < lanes; ++i)
+            {
+                control[i] = batchPids[i].control(setpoint - batch.getOutput(i));
+                plants[i].update(plantPids[i].control(setpoint - plants[i].getOutput()));
+            }
+            batch.update(control.data());
+
+            for (size_t i = 0; i < lanes; ++i)
+                deviation = std::max(deviation, std::fabs(batch.getOutput(i) - plants[i].getOutput()));
+        }
+        return deviation;
+    }
+}
+
+TEST(PlantBatchTest, PolySinMatchesStdSin)
+{
+    for (double x = -50.0; x <= 50.0; x += 0.001)
+        ASSERT_NEAR(polySin(x), std::sin(x), 4e-16 + 2e-16 * std::fabs(x)) << x;
+}
+
+TEST(PlantBatchTest, VectorSinMatchesScalarPolySinBitForBit)
+{
+    std::vector<double> in, out;
+    for (double x = -20.0; x <= 20.0; x += 0.0137)
+        in.push_back(x);
+    out.resize(in.size());
+
+    vectorSin(in.data(), out.data(), in.size());
+    for (size_t i = 0; i < in.size(); ++i)
+        ASSERT_EQ(out[i], polySin(in[i])) << in[i];
+}
+
+TEST(PlantBatchTest, OutOfRangeArgumentsFallBackToStdSin)
+{
+    const double inf = std::numeric_limits<double>::infinity();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    // Mixed with in-range values so the vector path sees partly bad groups, computed in place
+    std::vector<double> in = {0.5, 3e9, -1e12, 1.0, inf, -inf, nan, 2.0, 1e300, -0.25, 1e9};
+    std::vector<double> out = in;
+    vectorSin(out.data(), out.data(), out.size());
+
+    for (size_t i = 0; i < in.size(); ++i)
+    {
+        double expected = std::fabs(in[i]) <= 1e9 ? polySin(in[i]) : std::sin(in[i]);
+        if (std::isnan(expected))
+        {
+            EXPECT_TRUE(std::isnan(out[i])) << in[i];
+            EXPECT_TRUE(std::isnan(polySin(in[i]))) << in[i];
+        }
+        else
+        {
+            EXPECT_EQ(out[i], expected) << in[i];
+            EXPECT_EQ(polySin(in[i]), expected) << in[i];
+        }
+    }
+}
+
+TEST(PlantBatchTest, PositionLanesMatchSingleInstance)
+{
+    PositionSystemBatch batch(lanes);
+    std::vector<BasicPositionSystem<double>> plants;
+    for (size_t i = 0; i < lanes; ++i)
+    {
+        double dt = 0.05 + 0.01 * i;
+        batch.setTimeStep(i, dt);
+        plants.emplace_back(dt);
+    }
+    EXPECT_EQ(maxLaneDeviation(batch, plants, 1.0, 0.1, 0.05, 1.0, 200), 0.0);
+}
+
+TEST(PlantBatchTest, VelocityLanesMatchSingleInstance)
+{
+    VelocitySystemBatch batch(lanes);
+    std::vector<BasicVelocitySystem<double>> plants(lanes);
+    EXPECT_EQ(maxLaneDeviation(batch, plants, 1.0, 0.1, 0.05, 1.0, 200), 0.0);
+}
+
+TEST(PlantBatchTest, TemperatureLanesMatchSingleInstance)
+{
+    TemperatureSystemBatch batch(lanes);
+    std::vector<BasicTemperatureSystem<double>> plants(lanes);
+    EXPECT_EQ(maxLaneDeviation(batch, plants, 1.0, 0.1, 0.05, 100.0, 200), 0.0);
+}
+
+TEST(PlantBatchTest, PendulumLanesStayConsistentWithSingleInstance)
+{
+    InvertedPendulumSystemBatch batch(lanes);
+    std::vector<BasicInvertedPendulumSystem<double>> plants(lanes);
+    EXPECT_LT(maxLaneDeviation(batch, plants, 30.0, 1.0, 5.0, 0.0, 1000), 1e-13);
+}
+
+TEST(PlantBatchTest, UncontrolledPendulumFallsLikeSingleInstance)
+{
+    InvertedPendulumSystemBatch batch(lanes);
+    std::vector<BasicInvertedPendulumSystem<double>> plants(lanes);
+    EXPECT_LT(maxLaneDeviation(batch, plants, 0.0, 0.0, 0.0, 0.0, 300), 1e-12);
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <utility>
+#include <vector>
+#include "PlotBuffer.h"
+
+namespace
+{
+    std::vector<PlotPoint> sine(size_t n)
+    {
+        std::vector<PlotPoint> points;
+        for (size_t i = 0; i < n; ++i)
+            points.push_back({static_cast<float>(i), static_cast<float>(std::sin(0.01 * i))});
+        return points;
+    }
+}
+
+TEST(PlotRingTest, KeepsTheNewestPointsInOrder)
+{
+    PlotRing ring(4);
+    for (int i = 0; i < 6; ++i)
+        ring.push({static_cast<float>(i), static_cast<float>(10 * i)});
+
+    ASSERT_EQ(ring.size(), 4u);
+    for (size_t i = 0; i < ring.size(); ++i)
+        EXPECT_FLOAT_EQ(ring[i].x, static_cast<float>(i + 2));
+    EXPECT_EQ(ring.head(), 2u);
+}
+
+TEST(PlotRingTest, ReportsOnlyTheSlotsWrittenSinceTheLastUpload)
+{
+    PlotRing ring(4);
+    std::vector<std::pair<size_t, size_t>> ranges;
+    auto upload = [&](size_t first, size_t count)
+    { ranges.emplace_back(first, count); };
+
+    ring.push({0, 0});
+    ring.push({1, 1});
+    ring.takeDirty(upload);
+    ring.takeDirty(upload);
+    ASSERT_EQ(ranges.size(), 1u);
+    EXPECT_EQ(ranges[0], std::make_pair(size_t(0), size_t(2)));
+
+    // Slots 2, 3 and then 0 again: the range wraps
+    ranges.clear();
+    ring.push({2, 2});
+    ring.push({3, 3});
+    ring.push({4, 4});
+    ring.takeDirty(upload);
+    ASSERT_EQ(ranges.size(), 2u);
+    EXPECT_EQ(ranges[0], std::make_pair(size_t(2), size_t(2)));
+    EXPECT_EQ(ranges[1], std::make_pair(size_t(0), size_t(1)));
+}
+
+TEST(PlotRingTest, BoundsFollowEvictedExtremes)
+{
+    PlotRing ring(3);
+    ring.push({0, 5});
+    ring.push({1, -5});
+    ring.push({2, 1});
+    EXPECT_FLOAT_EQ(ring.minY(), -5.0f);
+    EXPECT_FLOAT_EQ(ring.maxY(), 5.0f);
+
+    ring.push({3, 2});
+    EXPECT_FLOAT_EQ(ring.maxY(), 2.0f);
+    ring.push({4, 0});
+    EXPECT_FLOAT_EQ(ring.minY(), 0.0f);
+}
+
+TEST(MinMaxDecimatorTest, BoundsPointsByColumnCount)
+{
+    std::vector<PlotPoint> points = sine(100000);
+    std::vector<PlotPoint> decimated = decimateMinMax(points, 100000.0 / 800.0);
+    EXPECT_LE(decimated.size(), 2u * 800u);
+    EXPECT_GE(decimated.size(), 800u);
+
+    for (size_t i = 1; i < decimated.size(); ++i)
+        EXPECT_LT(decimated[i - 1].x, decimated[i].x);
+}
+
+TEST(MinMaxDecimatorTest, KeepsSpikesWithinAColumn)
+{
+    std::vector<PlotPoint> points;
+    for (int i = 0; i < 1000; ++i)
+        points.push_back({static_cast<float>(i), i == 517 ? 100.0f : (i == 733 ? -100.0f : 0.0f)});
+
+    std::vector<PlotPoint> decimated = decimateMinMax(points, 500.0);
+    ASSERT_EQ(decimated.size(), 3u);
+    EXPECT_FLOAT_EQ(decimated[1].y, 100.0f);
+    EXPECT_FLOAT_EQ(decimated[1].x, 517.0f);
+    EXPECT_FLOAT_EQ(decimated[2].y, -100.0f);
+}
+
+TEST(MinMaxDecimatorTest, PassesSparseSamplesThrough)
+{
+    std::vector<PlotPoint> points = sine(50);
+    std::vector<PlotPoint> decimated = decimateMinMax(points, 1.0);
+    ASSERT_EQ(decimated.size(), points.size());
+    for (size_t i = 0; i < points.size(); ++i)
+        EXPECT_FLOAT_EQ(decimated[i].y, points[i].y);
+}
+
+TEST(LttbTest, ReturnsThresholdPointsKeepingTheEnds)
+{
+    std::vector<PlotPoint> points = sine(10000);
+    std::vector<PlotPoint> decimated = decimateLttb(points, 800);
+    ASSERT_EQ(decimated.size(), 800u);
+    EXPECT_FLOAT_EQ(decimated.front().x, points.front().x);
+    EXPECT_FLOAT_EQ(decimated.back().x, points.back().x);
+    for (size_t i = 1; i < decimated.size(); ++i)
+        EXPECT_LT(decimated[i - 1].x, decimated[i].x);
+}
+
+TEST(LttbTest, PicksThePeak)
+{
+    std::vector<PlotPoint> points;
+    for (int i = 0; i < 100; ++i)
+        points.push_back({static_cast<float>(i), i == 42 ? 10.0f : 0.0f});
+
+    std::vector<PlotPoint> decimated = decimateLttb(points, 10);
+    bool hasPeak = false;
+    for (const PlotPoint &p : decimated)
+        hasPeak = hasPeak || p.y == 10.0f;
+    EXPECT_TRUE(hasPeak);
+}
+
+TEST(LttbTest, LeavesShortSeriesAlone)
+{
+    std::vector<PlotPoint> points = sine(20);
+    EXPECT_EQ(decimateLttb(points, 50).size(), 20u);
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "BasicPID.h"
+#include "PositionSystem.h"
+#include "RealtimeExecutor.h"
+
+namespace
+{
+    RealtimeConfig fastConfig()
+    {
+        RealtimeConfig config;
+        config.period = std::chrono::milliseconds(2);
+        config.cpu = 0;
+        return config;
+    }
+}
+
+TEST(RealtimeExecutorTest, RunsEveryCycleOnTheAbsoluteSchedule)
+{
+    RealtimeExecutor executor(fastConfig());
+    std::vector<long long> cycles;
+
+    auto start = std::chrono::steady_clock::now();
+    PacingStats stats = executor.run(50, [&](long long k)
+                                     {
+        cycles.push_back(k);
+        std::this_thread::sleep_for(std::chrono::microseconds(500)); });
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    ASSERT_EQ(cycles.size(), 50u);
+    EXPECT_EQ(cycles.back(), 49);
+    EXPECT_EQ(stats.steps, 50);
+    // The work inside each cycle does not add up into drift; the upper bound only
+    // rules out relative sleeps (at least 0.125 s) on a loaded machine with slack
+    EXPECT_GE(elapsed, 0.1);
+    EXPECT_LT(elapsed, 0.5);
+}
+
+TEST(RealtimeExecutorTest, SetupFallsBackCleanlyAndReportsWhatItDid)
+{
+    RealtimeExecutor executor(fastConfig());
+    executor.run(1, [](long long) {});
+
+    const RealtimeSetup &setup = executor.setup();
+    EXPECT_TRUE(setup.stackPrefaulted);
+    // Pinning, locking and SCHED_FIFO depend on privileges: each either worked or says why not
+    int failures = !setup.pinned + !setup.memoryLocked + !setup.fifoScheduling;
+    EXPECT_EQ(static_cast<int>(setup.warnings.size()), failures);
+}
+
+TEST(RealtimeExecutorTest, CountsDeadlineMisses)
+{
+    RealtimeExecutor executor(fastConfig());
+    PacingStats stats = executor.run(10, [](long long k)
+                                     {
+        if (k == 3)
+            std::this_thread::sleep_for(std::chrono::milliseconds(5)); });
+
+    EXPECT_GE(stats.overruns, 1);
+    EXPECT_LE(stats.overruns, 3);
+    EXPECT_GE(stats.maxOverrun, std::chrono::milliseconds(2));
+}
+
+TEST(RealtimeExecutorTest, RethrowsExceptionsFromTheBodyAfterJoining)
+{
+    RealtimeExecutor executor(fastConfig());
+    long long ran = 0;
+    EXPECT_THROW(executor.run(10, [&](long long k)
+                              {
+        ++ran;
+        if (k == 2)
+            throw std::runtime_error("cycle failed"); }),
+                 std::runtime_error);
+    EXPECT_EQ(ran, 3);
+
+    // The executor is usable again afterwards
+    PacingStats stats = executor.run(2, [](long long) {});
+    EXPECT_EQ(stats.steps, 2);
+}
+
+TEST(RealtimeExecutorTest, SimulateRealtimeMatchesSimulate)
+{
+    PositionSystem rtPlant, plant;
+    BasicPID<double> rtPid(1.0, 0.1, 0.05), pid(1.0, 0.1, 0.05);
+
+    RealtimeConfig config = fastConfig();
+    config.period = std::chrono::microseconds(200);
+    RealtimeExecutor executor(config);
+    std::vector<StepSample> samples;
+    simulateRealtime(executor, rtPlant, rtPid, 1.0, 100, [&](const StepSample &s)
+                     { samples.push_back(s); });
+
+    simulate(plant, pid, 1.0, 100, Pacing::unthrottled(), [](const StepSample &) {});
+
+    ASSERT_EQ(samples.size(), 100u);
+    EXPECT_EQ(samples.back().step, 99);
+    EXPECT_EQ(rtPlant.getOutput(), plant.getOutput());
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <sstream>
+#include "PositionSystem.h"
+#include "ScenarioRunner.h"
+#include "Simulation.h"
+
+namespace
+{
+    const char *config = R"(
+# comment line
+position  position     1.0   50  1.0  0.1  0.05
+temp      temperature  100   80  1.0  0.1  0.05   dt=0.2 min=-50 max=50   # trailing comment
+
+pendulum  pendulum     0.0   30  30   1    5      antiwindup=0.5
+)";
+}
+
+TEST(ScenarioRunnerTest, ParsesPositionalFieldsAndOptions)
+{
+    std::istringstream in(config);
+    std::vector<Scenario> scenarios;
+    std::string error;
+    ASSERT_TRUE(parseScenarios(in, scenarios, error)) << error;
+    ASSERT_EQ(scenarios.size(), 3u);
+
+    EXPECT_EQ(scenarios[0].name, "position");
+    EXPECT_EQ(scenarios[0].steps, 50);
+    EXPECT_EQ(scenarios[0].timeStep, 0.0);
+
+    EXPECT_EQ(scenarios[1].plant, "temperature");
+    EXPECT_EQ(scenarios[1].setpoint, 100.0);
+    EXPECT_EQ(scenarios[1].timeStep, 0.2);
+    EXPECT_EQ(scenarios[1].gains.outputMin, -50.0);
+    EXPECT_EQ(scenarios[1].gains.outputMax, 50.0);
+
+    EXPECT_EQ(scenarios[2].gains.Kp, 30.0);
+    EXPECT_EQ(scenarios[2].gains.antiWindupGain, 0.5);
+}
+
+TEST(ScenarioRunnerTest, ReportsTheFirstMalformedLine)
+{
+    std::vector<Scenario> scenarios;
+    std::string error;
+
+    std::istringstream unknownPlant("a position 1 10 1 0 0\nb boiler 1 10 1 0 0\n");
+    EXPECT_FALSE(parseScenarios(unknownPlant, scenarios, error));
+    EXPECT_THAT(error, ::testing::HasSubstr("line 2"));
+    EXPECT_THAT(error, ::testing::HasSubstr("boiler"));
+
+    std::istringstream missingGain("a position 1 10 1 0\n");
+    EXPECT_FALSE(parseScenarios(missingGain, scenarios, error));
+
+    std::istringstream badOption("a position 1 10 1 0 0 gain=3\n");
+    EXPECT_FALSE(parseScenarios(badOption, scenarios, error));
+    EXPECT_THAT(error, ::testing::HasSubstr("gain=3"));
+}
+
+TEST(ScenarioRunnerTest, MatchesASequentialRunWithAFreshController)
+{
+    Scenario scenario;
+    scenario.name = "position";
+    scenario.plant = "position";
+    scenario.steps = 60;
+
+    ThreadPool pool(2);
+    ScenarioResult result = ScenarioRunner(pool).run(scenario);
+
+    PositionSystem plant;
+    BasicPID<double> pid(1.0, 0.1, 0.05);
+    std::vector<StepSample> expected;
+    simulate(plant, pid, 1.0, 60, Pacing::unthrottled(), [&](const StepSample &s)
+             { expected.push_back(s); });
+
+    ASSERT_EQ(result.samples.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+        EXPECT_EQ(result.samples[i].response, expected[i].response) << "step " << i;
+}
+
+TEST(ScenarioRunnerTest, ParallelResultsKeepInputOrderAndDoNotShareState)
+{
+    std::vector<Scenario> scenarios;
+    for (int i = 0; i < 32; ++i)
+    {
+        Scenario scenario;
+        scenario.name = "run" + std::to_string(i);
+        scenario.plant = i % 2 ? "velocity" : "position";
+        scenario.steps = 200;
+        scenarios.push_back(scenario);
+    }
+
+    ThreadPool single(1), many(4);
+    std::vector<ScenarioResult> sequential = ScenarioRunner(single).runAll(scenarios);
+    std::vector<ScenarioResult> parallel = ScenarioRunner(many).runAll(scenarios);
+
+    ASSERT_EQ(parallel.size(), scenarios.size());
+    for (size_t i = 0; i < scenarios.size(); ++i)
+    {
+        EXPECT_EQ(parallel[i].name, scenarios[i].name);
+        ASSERT_EQ(parallel[i].samples.size(), 200u);
+        // Identical scenarios give identical traces: no controller is reused
+        EXPECT_EQ(parallel[i].samples.back().response, parallel[i % 2].samples.back().response);
+        EXPECT_EQ(parallel[i].samples.back().response, sequential[i].samples.back().response);
+    }
+}
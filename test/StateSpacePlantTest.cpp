@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cmath>
+#include "BasicPID.h"
+#include "InvertedPendulumSystem.h"
+#include "PositionSystem.h"
+#include "StateSpacePlant.h"
+#include "TemperatureSystem.h"
+#include "VelocitySystem.h"
+
+namespace
+{
+    // Runs the same PID loop on both plants and returns the largest output difference
+    template <typename Reference, typename Candidate>
+    double maxDeviation(Reference &reference, Candidate &candidate, double Kp, double Ki, double Kd,
+                        double setpoint, int steps)
+    {
+        BasicPID<double> referencePid(Kp, Ki, Kd), candidatePid(Kp, Ki, Kd);
+        double deviation = 0.0;
+        for (int i = 0; i < steps; ++i)
+        {
+            double expected = reference.update(referencePid.control(setpoint - reference.getOutput()));
+            double actual = candidate.update(candidatePid.control(setpoint - candidate.getOutput()));
+            deviation = std::max(deviation, std::fabs(actual - expected));
+        }
+        return deviation;
+    }
+}
+
+TEST(StateSpacePlantTest, PositionInstanceMatchesHandwrittenPlant)
+{
+    PositionSystem reference;
+    SISOStateSpacePlant<2> candidate(makePositionStateSpace());
+    EXPECT_LT(maxDeviation(reference, candidate, 1.0, 0.1, 0.05, 1.0, 200), 1e-12);
+}
+
+TEST(StateSpacePlantTest, VelocityInstanceMatchesHandwrittenPlant)
+{
+    VelocitySystem reference;
+    SISOStateSpacePlant<1> candidate(makeVelocityStateSpace());
+    EXPECT_EQ(maxDeviation(reference, candidate, 1.0, 0.1, 0.05, 1.0, 200), 0.0);
+}
+
+TEST(StateSpacePlantTest, TemperatureInstanceMatchesHandwrittenPlant)
+{
+    TemperatureSystem reference;
+    SISOStateSpacePlant<1> candidate(makeTemperatureStateSpace());
+    EXPECT_DOUBLE_EQ(candidate.getOutput(), 20.0);
+    EXPECT_EQ(maxDeviation(reference, candidate, 1.0, 0.1, 0.05, 100.0, 200), 0.0);
+}
+
+TEST(StateSpacePlantTest, LinearisedPendulumTracksPendulumForSmallAngles)
+{
+    InvertedPendulumSystem reference;
+    SISOStateSpacePlant<2> candidate(makeLinearisedPendulumStateSpace());
+    // Free swing with |angle| <= 0.1, where sin(angle) differs from angle by < 0.2 %
+    EXPECT_LT(maxDeviation(reference, candidate, 0.0, 0.0, 0.0, 0.0, 500), 1e-3);
+}
+
+TEST(StateSpacePlantTest, AdvanceMatchesRepeatedUpdate)
+{
+    StateSpacePlant<2, 1, 1> stepped = makeLinearisedPendulumStateSpace();
+    StateSpacePlant<2, 1, 1> jumped = stepped;
+
+    for (int i = 0; i < 1000; ++i)
+        stepped.update({0.5});
+    jumped.advance({0.5}, 1000);
+
+    EXPECT_NEAR(jumped.state()[0], stepped.state()[0], 1e-10);
+    EXPECT_NEAR(jumped.state()[1], stepped.state()[1], 1e-10);
+    EXPECT_EQ(jumped.output()[0], jumped.state()[0]);
+}
+
+TEST(StateSpacePlantTest, AdvanceAgreesWithClosedFormPositionAdvance)
+{
+    PositionSystem closedForm;
+    SISOStateSpacePlant<2> squared(makePositionStateSpace());
+
+    EXPECT_NEAR(squared.advance(0.3, 123456), closedForm.advance(0.3, 123456), 1e-12 * 0.3 * 0.01 * 123456.0 * 123457.0);
+}
+
+TEST(StateSpacePlantTest, MultiInputMultiOutput)
+{
+    // Two decoupled integrators, outputs are the states and their sum
+    StateSpacePlant<2, 2, 3> plant({{{1.0, 0.0}, {0.0, 1.0}}}, {{{1.0, 0.0}, {0.0, 2.0}}},
+                                   {{{1.0, 0.0}, {0.0, 1.0}, {1.0, 1.0}}}, {{{0.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}}});
+    const auto &y = plant.update({1.0, 1.0});
+
+    EXPECT_DOUBLE_EQ(y[0], 1.0);
+    EXPECT_DOUBLE_EQ(y[1], 2.0);
+    EXPECT_DOUBLE_EQ(y[2], 3.0);
+}
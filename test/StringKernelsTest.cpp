@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cstring>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include "StringKernels.h"
+
+namespace
+{
+    std::vector<StringKernel> kernels()
+    {
+        std::vector<StringKernel> result{StringKernel::Scalar};
+        if (bestStringKernel() != StringKernel::Scalar)
+            result.push_back(StringKernel::SSE42);
+        if (bestStringKernel() == StringKernel::AVX2)
+            result.push_back(StringKernel::AVX2);
+        return result;
+    }
+
+    // A small alphabet makes partial matches, and so the tricky paths, common
+    std::string randomText(std::mt19937 &rng, size_t size)
+    {
+        std::uniform_int_distribution<int> letter('a', 'd');
+        std::string text(size, ' ');
+        for (char &c : text)
+            c = static_cast<char>(letter(rng));
+        return text;
+    }
+
+    int sign(int x)
+    {
+        return (x > 0) - (x < 0);
+    }
+}
+
+TEST(StringKernelsTest, CompareAgreesWithMemcmp)
+{
+    std::mt19937 rng(1);
+    for (size_t size = 0; size < 130; ++size)
+    {
+        std::string a = randomText(rng, size);
+        for (size_t at = 0; at <= size; ++at)
+        {
+            std::string b = a;
+            if (at < size)
+                b[at] = static_cast<char>(at % 2 ? 0x80 : 'A'); // above and below the alphabet
+            for (StringKernel kernel : kernels())
+            {
+                EXPECT_EQ(sign(stringCompare(a.data(), b.data(), size, kernel)), sign(std::memcmp(a.data(), b.data(), size)))
+                    << "size " << size << " at " << at << " kernel " << static_cast<int>(kernel);
+                EXPECT_EQ(stringEqual(a.data(), b.data(), size, kernel), at == size);
+            }
+        }
+    }
+}
+
+TEST(StringKernelsTest, FindCharAgreesWithStdString)
+{
+    std::mt19937 rng(2);
+    for (size_t size = 0; size < 200; ++size)
+    {
+        std::string text = randomText(rng, size);
+        for (char c : {'a', 'd', 'z'})
+        {
+            size_t expected = text.find(c);
+            for (StringKernel kernel : kernels())
+                EXPECT_EQ(stringFind(text.data(), size, c, kernel), expected == std::string::npos ? stringNpos : expected);
+        }
+    }
+}
+
+TEST(StringKernelsTest, FindSubstringAgreesWithStdString)
+{
+    std::mt19937 rng(3);
+    for (int trial = 0; trial < 3000; ++trial)
+    {
+        size_t size = std::uniform_int_distribution<size_t>(0, 150)(rng);
+        size_t needleSize = std::uniform_int_distribution<size_t>(0, 40)(rng);
+        std::string text = randomText(rng, size);
+        std::string needle = randomText(rng, needleSize);
+        // Often plant the needle, near the end included
+        if (trial % 2 && needleSize <= size)
+            text.replace(std::uniform_int_distribution<size_t>(0, size - needleSize)(rng), needleSize, needle);
+
+        size_t expected = text.find(needle);
+        for (StringKernel kernel : kernels())
+        {
+            EXPECT_EQ(stringFind(text.data(), size, needle.data(), needleSize, kernel),
+                      expected == std::string::npos ? stringNpos : expected)
+                << "text " << text << " needle " << needle << " kernel " << static_cast<int>(kernel);
+        }
+    }
+}
+
+TEST(StringKernelsTest, FindDoesNotMatchPastTheEnd)
+{
+    // The needle continues beyond `size` in memory but must not be found
+    const char *text = "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxabc";
+    for (StringKernel kernel : kernels())
+    {
+        EXPECT_EQ(stringFind(text, 41, "abc", 3, kernel), stringNpos);
+        EXPECT_EQ(stringFind(text, 43, "abc", 3, kernel), 40u);
+        EXPECT_EQ(stringFind(text, 40, 'a', kernel), stringNpos);
+    }
+}
+
+TEST(StringKernelsTest, HashIsDeterministicAndSpreadsNearbyInputs)
+{
+    std::set<uint64_t> hashes;
+    std::string text;
+    for (int i = 0; i < 300; ++i)
+    {
+        EXPECT_EQ(stringHash(text.data(), text.size()), stringHash(text.c_str(), text.size()));
+        hashes.insert(stringHash(text.data(), text.size()));
+        text += static_cast<char>('a' + i % 3);
+    }
+    EXPECT_EQ(hashes.size(), 300u);
+
+    // Single-bit flips at every position change the hash
+    std::string base(100, 'q');
+    uint64_t baseHash = stringHash(base.data(), base.size());
+    for (size_t i = 0; i < base.size(); ++i)
+    {
+        std::string flipped = base;
+        flipped[i] ^= 1;
+        EXPECT_NE(stringHash(flipped.data(), flipped.size()), baseHash) << i;
+    }
+
+    EXPECT_NE(stringHash("abc", 3, 1), stringHash("abc", 3, 2));
+}
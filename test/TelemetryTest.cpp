@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "PositionSystem.h"
+#include "BasicPID.h"
+#include "Simulation.h"
+#include "SpscRing.h"
+#include "Telemetry.h"
+
+namespace
+{
+    std::string tempPath(const char *name)
+    {
+        return testing::TempDir() + name;
+    }
+
+    StepSample sampleFor(long long i)
+    {
+        return StepSample{i, 1.0, 0.5 * i, 1.0 - 0.5 * i, 2.0 * i, 0.25 * i};
+    }
+}
+
+TEST(SpscRingTest, CapacityRoundsUpToPowerOfTwo)
+{
+    SpscRing<int> ring(5);
+    EXPECT_EQ(ring.capacity(), 8u);
+}
+
+TEST(SpscRingTest, RejectsPushWhenFullAndKeepsFifoOrderAcrossWrap)
+{
+    SpscRing<int> ring(4);
+    int next = 0, expected = 0, value;
+
+    for (int round = 0; round < 10; ++round)
+    {
+        while (ring.tryPush(next))
+            ++next;
+        EXPECT_EQ(ring.size(), 4u);
+
+        // Drain half, so the indices wrap around the storage
+        for (int i = 0; i < 2; ++i)
+        {
+            ASSERT_TRUE(ring.tryPop(value));
+            EXPECT_EQ(value, expected++);
+        }
+    }
+
+    int batch[8];
+    size_t count = ring.popBatch(batch, 8);
+    ASSERT_EQ(count, 2u);
+    EXPECT_EQ(batch[0], expected);
+    EXPECT_EQ(batch[1], expected + 1);
+    EXPECT_FALSE(ring.tryPop(value));
+}
+
+TEST(SpscRingTest, ConcurrentProducerAndConsumerSeeEveryValueInOrder)
+{
+    SpscRing<long long> ring(64);
+    const long long total = 200000;
+
+    std::thread producer([&]
+                         {
+        for (long long i = 0; i < total; ++i)
+            while (!ring.tryPush(i))
+                std::this_thread::yield(); });
+
+    long long expected = 0;
+    long long batch[16];
+    while (expected < total)
+    {
+        size_t count = ring.popBatch(batch, 16);
+        if (count == 0)
+            std::this_thread::yield();
+        // After a mismatch keep draining so the producer can finish, but report only the first
+        for (size_t i = 0; i < count; ++i, ++expected)
+        {
+            if (!HasFailure())
+            {
+                EXPECT_EQ(batch[i], expected);
+            }
+        }
+    }
+    producer.join();
+}
+
+TEST(TelemetryTest, RoundTripsEveryRecordedSample)
+{
+    std::string path = tempPath("telemetry_roundtrip.bin");
+    {
+        TelemetryLogger logger(path, 1 << 12, 64);
+        ASSERT_TRUE(logger.isOpen());
+        for (long long i = 0; i < 1000; ++i)
+            EXPECT_TRUE(logger.record(sampleFor(i)));
+        logger.close();
+        EXPECT_EQ(logger.recorded(), 1000);
+        EXPECT_EQ(logger.written(), 1000);
+        EXPECT_EQ(logger.dropped(), 0);
+        EXPECT_FALSE(logger.writeFailed());
+    }
+
+    std::vector<StepSample> samples;
+    ASSERT_TRUE(readTelemetry(path, samples));
+    ASSERT_EQ(samples.size(), 1000u);
+    for (long long i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(samples[i].step, i);
+        EXPECT_EQ(samples[i].control, sampleFor(i).control);
+        EXPECT_EQ(samples[i].response, sampleFor(i).response);
+    }
+    std::remove(path.c_str());
+}
+
+TEST(TelemetryTest, FullRingDropsInsteadOfBlocking)
+{
+    std::string path = tempPath("telemetry_drops.bin");
+    TelemetryLogger logger(path, 4, 4);
+    const long long total = 100000;
+
+    long long accepted = 0;
+    for (long long i = 0; i < total; ++i)
+        accepted += logger.record(sampleFor(i)) ? 1 : 0;
+    logger.close();
+
+    // Whatever the writer managed to keep up with is on disk, the rest is counted
+    EXPECT_EQ(logger.recorded(), accepted);
+    EXPECT_EQ(logger.recorded() + logger.dropped(), total);
+    EXPECT_EQ(logger.written(), accepted);
+
+    std::vector<StepSample> samples;
+    ASSERT_TRUE(readTelemetry(path, samples));
+    EXPECT_EQ(static_cast<long long>(samples.size()), accepted);
+    for (size_t i = 1; i < samples.size(); ++i)
+        EXPECT_LT(samples[i - 1].step, samples[i].step);
+    std::remove(path.c_str());
+}
+
+TEST(TelemetryTest, UnwritablePathDropsEverything)
+{
+    TelemetryLogger logger("/nonexistent-directory/telemetry.bin");
+    EXPECT_FALSE(logger.isOpen());
+    EXPECT_FALSE(logger.record(sampleFor(0)));
+    EXPECT_EQ(logger.dropped(), 1);
+}
+
+TEST(TelemetryTest, FailedWritesAreReported)
+{
+    // /dev/full opens fine but every write fails with ENOSPC
+    TelemetryLogger logger("/dev/full", 1 << 12, 64);
+    if (!logger.isOpen())
+        GTEST_SKIP() << "/dev/full is not available";
+    for (long long i = 0; i < 1000; ++i)
+        logger.record(sampleFor(i));
+    logger.close();
+    EXPECT_TRUE(logger.writeFailed());
+    EXPECT_LT(logger.written(), logger.recorded());
+}
+
+TEST(TelemetryTest, RejectsFilesWithoutTheHeader)
+{
+    std::string path = tempPath("telemetry_garbage.bin");
+    std::FILE *file = std::fopen(path.c_str(), "wb");
+    std::fputs("step,setpoint\n", file);
+    std::fclose(file);
+
+    std::vector<StepSample> samples;
+    EXPECT_FALSE(readTelemetry(path, samples));
+    EXPECT_FALSE(readTelemetry(tempPath("telemetry_missing.bin"), samples));
+    std::remove(path.c_str());
+}
+
+TEST(TelemetryTest, CsvHasHeaderAndOneLinePerSample)
+{
+    std::ostringstream csv;
+    writeTelemetryCsv({sampleFor(0), sampleFor(3)}, csv);
+    EXPECT_EQ(csv.str(), "step,setpoint,output,error,control,response\n"
+                         "0,1,0,1,0,0\n"
+                         "3,1,1.5,-0.5,6,0.75\n");
+}
+
+TEST(TelemetryTest, SimulateFeedsTheLoggerEveryStep)
+{
+    std::string path = tempPath("telemetry_simulate.bin");
+    PositionSystem plant;
+    BasicPID<double> pid(1.0, 0.1, 0.05);
+
+    TelemetryLogger logger(path);
+    simulate(plant, pid, 1.0, 50, Pacing::unthrottled(), logger);
+    logger.close();
+
+    std::vector<StepSample> samples;
+    ASSERT_TRUE(readTelemetry(path, samples));
+    ASSERT_EQ(samples.size(), 50u);
+    EXPECT_EQ(samples.back().step, 49);
+    EXPECT_EQ(samples.back().response, plant.getOutput());
+    std::remove(path.c_str());
+}
+
+TEST(TelemetryTest, ConsoleObserverPrintsTheOriginalFormat)
+{
+    std::ostringstream out;
+    ConsoleObserver{out}(sampleFor(2));
+    EXPECT_EQ(out.str(), "Step 2 | Setpoint: 1 | Output: 1 | Error: 0 | Control: 4 | Response: 0.5\n");
+}
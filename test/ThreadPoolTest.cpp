@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include "ThreadPool.h"
+
+TEST(ThreadPoolTest, ParallelForVisitsEveryIndexOnce)
+{
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> visits(1000);
+
+    pool.parallelFor(visits.size(), [&](size_t i)
+                     { visits[i].fetch_add(1); });
+
+    for (auto &v : visits)
+        EXPECT_EQ(v.load(), 1);
+}
+
+TEST(ThreadPoolTest, NestedParallelForDoesNotDeadlock)
+{
+    ThreadPool pool(2);
+    std::atomic<int> total{0};
+
+    pool.parallelFor(8, [&](size_t)
+                     { pool.parallelFor(8, [&](size_t)
+                                        { total.fetch_add(1); }); });
+
+    EXPECT_EQ(total.load(), 64);
+}
+
+TEST(ThreadPoolTest, ParallelForRethrowsAfterAllTasksRan)
+{
+    ThreadPool pool(3);
+    std::atomic<int> ran{0};
+
+    EXPECT_THROW(pool.parallelFor(50, [&](size_t i)
+                                  {
+        ran.fetch_add(1);
+        if (i == 10)
+            throw std::runtime_error("boom"); }),
+                 std::runtime_error);
+    EXPECT_EQ(ran.load(), 50);
+}
+
+TEST(ThreadPoolTest, SubmittedTasksRunBeforeDestruction)
+{
+    std::atomic<int> ran{0};
+    {
+        ThreadPool pool(2);
+        for (int i = 0; i < 100; ++i)
+            pool.submit([&]()
+                        { ran.fetch_add(1); });
+    }
+    EXPECT_EQ(ran.load(), 100);
+}
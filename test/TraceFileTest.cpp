@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "BasicPID.h"
+#include "PositionSystem.h"
+#include "Simulation.h"
+#include "TraceFile.h"
+
+namespace
+{
+    std::string tempPath(const char *name)
+    {
+        return testing::TempDir() + name;
+    }
+
+    std::vector<StepSample> runOf(int steps, double scale)
+    {
+        std::vector<StepSample> samples;
+        for (int k = 0; k < steps; ++k)
+            samples.push_back({k, scale, scale * k, scale - scale * k, -scale * k, scale * (k + 1)});
+        return samples;
+    }
+}
+
+TEST(TraceFileTest, RoundTripsRunsAsColumns)
+{
+    std::string path = tempPath("trace_roundtrip.trace");
+    {
+        TraceWriter writer(path);
+        ASSERT_TRUE(writer.isOpen());
+        EXPECT_TRUE(writer.appendRun(runOf(10, 1.0)));
+        EXPECT_TRUE(writer.appendRun({}));
+        EXPECT_TRUE(writer.appendRun(runOf(3, 2.5)));
+        EXPECT_EQ(writer.runCount(), 3u);
+        EXPECT_TRUE(writer.close());
+    }
+
+    TraceReader reader(path);
+    ASSERT_TRUE(reader.isOpen());
+    ASSERT_EQ(reader.runCount(), 3u);
+
+    TraceRun first = reader.run(0);
+    ASSERT_EQ(first.size(), 10u);
+    EXPECT_EQ(first.step[9], 9);
+    EXPECT_EQ(first.output[4], 4.0);
+    EXPECT_EQ(first.response[9], 10.0);
+
+    EXPECT_EQ(reader.run(1).size(), 0u);
+
+    TraceRun third = reader.run(2);
+    ASSERT_EQ(third.size(), 3u);
+    StepSample s = third.sample(2);
+    EXPECT_EQ(s.step, 2);
+    EXPECT_EQ(s.setpoint, 2.5);
+    EXPECT_EQ(s.error, 2.5 - 5.0);
+    EXPECT_EQ(s.control, -5.0);
+
+    double sum = 0.0;
+    for (double u : first.control)
+        sum += u;
+    EXPECT_EQ(sum, -45.0);
+    std::remove(path.c_str());
+}
+
+TEST(TraceFileTest, RecordsSimulateRunsInPlaceAndGrowsTheFile)
+{
+    std::string path = tempPath("trace_simulate.trace");
+    const int runs = 50, steps = 5000; // 50 * 5000 * 48 bytes: well past the initial mapping
+
+    std::vector<double> finals;
+    {
+        TraceWriter writer(path);
+        for (int r = 0; r < runs; ++r)
+        {
+            PositionSystem plant;
+            BasicPID<double> pid(1.0, 0.1 * r, 0.05);
+            ASSERT_TRUE(writer.beginRun(steps));
+            simulate(plant, pid, 1.0, steps, Pacing::unthrottled(), writer);
+            writer.endRun();
+            finals.push_back(plant.getOutput());
+        }
+    }
+
+    TraceReader reader(path);
+    ASSERT_TRUE(reader.isOpen());
+    ASSERT_EQ(reader.runCount(), static_cast<size_t>(runs));
+    for (int r = 0; r < runs; ++r)
+    {
+        TraceRun run = reader.run(r);
+        ASSERT_EQ(run.size(), static_cast<size_t>(steps));
+        EXPECT_EQ(run.response[steps - 1], finals[r]);
+    }
+    std::remove(path.c_str());
+}
+
+TEST(TraceFileTest, ShortRunsKeepOnlyStoredSamplesAndExtraSamplesAreDropped)
+{
+    std::string path = tempPath("trace_partial.trace");
+    {
+        TraceWriter writer(path);
+        ASSERT_TRUE(writer.beginRun(10));
+        EXPECT_FALSE(writer.beginRun(5)); // one run at a time
+        for (const StepSample &s : runOf(4, 1.0))
+            writer(s);
+        writer.endRun();
+
+        ASSERT_TRUE(writer.beginRun(2));
+        for (const StepSample &s : runOf(5, 3.0))
+            writer(s);
+        // close() ends the open run
+    }
+
+    TraceReader reader(path);
+    ASSERT_TRUE(reader.isOpen());
+    ASSERT_EQ(reader.runCount(), 2u);
+    EXPECT_EQ(reader.run(0).size(), 4u);
+    EXPECT_EQ(reader.run(1).size(), 2u);
+    EXPECT_EQ(reader.run(1).setpoint[1], 3.0);
+    std::remove(path.c_str());
+}
+
+TEST(TraceFileTest, RejectsMissingAndForeignFiles)
+{
+    EXPECT_FALSE(TraceReader(tempPath("trace_missing.trace")).isOpen());
+
+    std::string path = tempPath("trace_foreign.trace");
+    std::FILE *file = std::fopen(path.c_str(), "wb");
+    std::vector<char> junk(256, 'x');
+    std::fwrite(junk.data(), 1, junk.size(), file);
+    std::fclose(file);
+    EXPECT_FALSE(TraceReader(path).isOpen());
+    std::remove(path.c_str());
+
+    EXPECT_FALSE(TraceWriter("/nonexistent-directory/x.trace").isOpen());
+}
+
+TEST(TraceFileTest, RejectsRunsTooLargeToAddress)
+{
+    std::string path = tempPath("trace_huge.trace");
+    TraceWriter writer(path);
+    ASSERT_TRUE(writer.isOpen());
+    EXPECT_FALSE(writer.beginRun(SIZE_MAX / 8));
+    EXPECT_FALSE(writer.beginRun(SIZE_MAX));
+    EXPECT_TRUE(writer.appendRun(runOf(3, 1.0)));
+    EXPECT_TRUE(writer.close());
+    std::remove(path.c_str());
+}
+
+TEST(TraceFileTest, RejectsMisalignedOffsets)
+{
+    std::string path = tempPath("trace_misaligned.trace");
+    {
+        TraceWriter writer(path);
+        ASSERT_TRUE(writer.appendRun(runOf(10, 1.0)));
+        ASSERT_TRUE(writer.close());
+    }
+    ASSERT_TRUE(TraceReader(path).isOpen());
+
+    // Header: magic, version, runCount, indexOffset; index entry: offset, capacity, steps
+    auto patchWord = [&](long position, uint64_t value)
+    {
+        std::FILE *file = std::fopen(path.c_str(), "r+b");
+        std::fseek(file, position, SEEK_SET);
+        std::fwrite(&value, sizeof(value), 1, file);
+        std::fclose(file);
+    };
+    auto readWord = [&](long position)
+    {
+        uint64_t value = 0;
+        std::FILE *file = std::fopen(path.c_str(), "rb");
+        std::fseek(file, position, SEEK_SET);
+        EXPECT_EQ(std::fread(&value, sizeof(value), 1, file), 1u);
+        std::fclose(file);
+        return value;
+    };
+
+    const uint64_t indexOffset = readWord(24);
+    const uint64_t runOffset = readWord(static_cast<long>(indexOffset));
+
+    patchWord(static_cast<long>(indexOffset), runOffset + 4);
+    EXPECT_FALSE(TraceReader(path).isOpen());
+    patchWord(static_cast<long>(indexOffset), runOffset);
+    EXPECT_TRUE(TraceReader(path).isOpen());
+
+    patchWord(24, indexOffset - 4);
+    EXPECT_FALSE(TraceReader(path).isOpen());
+    std::remove(path.c_str());
+}
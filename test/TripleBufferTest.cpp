@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <thread>
+#include "TripleBuffer.h"
+#include "PID.h"
+
+TEST(TripleBufferTest, ReaderSeesNothingUntilWritten)
+{
+    TripleBuffer<int> buffer(7);
+    EXPECT_FALSE(buffer.update());
+    EXPECT_EQ(buffer.read(), 7);
+}
+
+TEST(TripleBufferTest, ReaderGetsLatestValue)
+{
+    TripleBuffer<int> buffer(0);
+    buffer.write(1);
+    buffer.write(2);
+    buffer.write(3);
+
+    EXPECT_TRUE(buffer.update());
+    EXPECT_EQ(buffer.read(), 3);
+    EXPECT_FALSE(buffer.update());
+    EXPECT_EQ(buffer.read(), 3);
+}
+
+TEST(TripleBufferTest, PublishedGainsApplyOnNextControl)
+{
+    PID pid(1.0, 0.0, 0.0);
+    pid.publishGains({2.0, 0.0, 0.0, 1.0, -1000.0, 1000.0});
+
+    EXPECT_DOUBLE_EQ(pid.control(3.0), 6.0);
+    EXPECT_DOUBLE_EQ(pid.gains().outputMax, 1000.0);
+}
+
+TEST(TripleBufferTest, LocalSettersStillWork)
+{
+    PID pid(1.0, 0.0, 0.0);
+    pid.publishGains({2.0, 0.0, 0.0, 1.0, -100.0, 100.0});
+    pid.control(0.0);
+    pid.setKp(4.0);
+
+    EXPECT_DOUBLE_EQ(pid.control(1.0), 4.0);
+}
+
+// One thread retunes as fast as it can while another runs the loop at full rate.
+// Every set the control thread uses must be one that was published as a whole,
+// and sets must never go back in time.
+TEST(TripleBufferTest, ConcurrentRetuningNeverTearsGainSets)
+{
+    constexpr int publishes = 200000;
+    PID pid(1.0, 2.0, 3.0);
+    pid.setOutputLimits(-1.0, 1.0);
+
+    std::atomic<bool> done{false};
+    std::thread tuner([&]()
+                      {
+        for (int k = 1; k <= publishes; ++k)
+        {
+            double g = k;
+            pid.publishGains({g, 2.0 * g, 3.0 * g, 1.0 / g, -g, g});
+        }
+        done.store(true, std::memory_order_release); });
+
+    double lastKp = 1.0;
+    long controlCalls = 0;
+    while (!done.load(std::memory_order_acquire) || controlCalls < 1000)
+    {
+        pid.reset();
+        double output = pid.control(1.0);
+        PIDGains<double> g = pid.gains();
+        ++controlCalls;
+
+        EXPECT_EQ(g.Ki, 2.0 * g.Kp);
+        EXPECT_EQ(g.Kd, 3.0 * g.Kp);
+        EXPECT_EQ(g.antiWindupGain, 1.0 / g.Kp);
+        EXPECT_EQ(g.outputMin, -g.Kp);
+        EXPECT_EQ(g.outputMax, g.Kp);
+        EXPECT_GE(g.Kp, lastKp);
+        EXPECT_DOUBLE_EQ(output, std::min(6.0 * g.Kp, g.outputMax));
+        lastKp = g.Kp;
+
+        // Stop at the first torn set; the tuner must still be joined below
+        if (HasFailure())
+            break;
+    }
+    tuner.join();
+    ASSERT_FALSE(HasFailure());
+
+    pid.control(0.0);
+    EXPECT_EQ(pid.gains().Kp, static_cast<double>(publishes));
+}